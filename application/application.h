@@ -36,6 +36,9 @@ namespace AIAssistant
 
         virtual bool IsFinished() const = 0;
 
+        // busy: the run loop renders at the configured frame rate, idle: it sleeps until woken up
+        virtual bool IsBusy() const { return true; }
+
     private:
     };
 } // namespace AIAssistant
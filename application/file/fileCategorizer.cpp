@@ -21,6 +21,7 @@
 
 #include "jarvisAgent.h"
 #include "file/probUtils.h"
+#include "file/markdownChunker.h"
 #include "file/fileCategorizer.h"
 #include "auxiliary/file.h"
 #include <algorithm>
@@ -32,7 +33,8 @@ namespace AIAssistant
 
     fs::path const FileCategorizer::AddFile(fs::path const& filePath)
     {
-        FileCategory category = Categorize(filePath);
+        FileIngestion ingestion(filePath);
+        FileCategory category = Categorize(filePath, ingestion);
         auto& categoryMap = [&]() -> TrackedFiles&
         {
             switch (category)
@@ -55,7 +57,8 @@ namespace AIAssistant
         }();
 
         std::string key = filePath.string();
-        categoryMap.Write()[key] = std::make_unique<TrackedFile>(filePath, category); // constructs and marks modified = true
+        // constructs and marks modified = true
+        categoryMap.Write()[key] = std::make_unique<TrackedFile>(filePath, category, ingestion);
         categoryMap.IncrementModifiedFiles();
         return filePath;
     }
@@ -73,7 +76,8 @@ namespace AIAssistant
 
     fs::path const FileCategorizer::ModifyFile(fs::path const& filePath)
     {
-        FileCategory category = Categorize(filePath);
+        FileIngestion ingestion(filePath);
+        FileCategory category = Categorize(filePath, ingestion);
         if (category == FileCategory::Ignored)
         {
             return {};
@@ -103,7 +107,7 @@ namespace AIAssistant
         auto it = map.find(filePath.string());
         if (it != map.end())
         {
-            if (it->second->CheckIfContentChanged())
+            if (it->second->CheckIfContentChanged(ingestion))
             {
                 if (!it->second->IsModified())
                 {
@@ -137,7 +141,7 @@ namespace AIAssistant
         }
     }
 
-    FileCategory FileCategorizer::Categorize(fs::path const& filePath) const
+    FileCategory FileCategorizer::Categorize(fs::path const& filePath, FileIngestion& ingestion) const
     {
         std::string filename = filePath.filename().string();
 
@@ -152,6 +156,12 @@ namespace AIAssistant
             return FileCategory::Ignored;
         }
 
+        // audit copies of document chunks, the document itself is the requirement
+        if (MarkdownChunker::IsInChunkFolder(filePath))
+        {
+            return FileCategory::Ignored;
+        }
+
         if (filename.starts_with("STNG"))
         {
             return FileCategory::Settings;
@@ -191,20 +201,22 @@ namespace AIAssistant
 
         // --- Quick magic-number check for common binary formats ---
         {
-            std::ifstream f(filePath, std::ios::binary);
-            if (!f)
+            if (!ingestion.IsReadable())
             {
                 LOG_APP_WARN("Could not open file for content check: {}", filePath.string());
                 return FileCategory::Ignored;
             }
 
-            std::array<unsigned char, 8> header{};
-            f.read(reinterpret_cast<char*>(header.data()), header.size());
-            size_t n = static_cast<size_t>(f.gcount());
+            std::string_view header = ingestion.GetHeader();
+            size_t n = header.size();
 
             // Define a small lambda for header comparison
             auto match = [&](std::initializer_list<unsigned char> sig)
-            { return n >= sig.size() && std::equal(sig.begin(), sig.end(), header.begin()); };
+            {
+                return n >= sig.size() && std::equal(sig.begin(), sig.end(), header.begin(),
+                                                     [](unsigned char lhs, char rhs)
+                                                     { return lhs == static_cast<unsigned char>(rhs); });
+            };
 
             // ZIP files and ZIP-based formats (DOCX, XLSX, PPTX, ODT)
             bool isZipFormat = match({0x50, 0x4B, 0x03, 0x04});
@@ -246,17 +258,8 @@ namespace AIAssistant
 
         // --- Check file readability (is it likely text?) ---
         {
-            std::ifstream file(filePath, std::ios::binary);
-            if (!file)
-            {
-                LOG_APP_WARN("Could not open file for content check: {}", filePath.string());
-                return FileCategory::Ignored;
-            }
-
-            constexpr size_t kSampleSize = 256;
-            char buffer[kSampleSize]{};
-            file.read(buffer, kSampleSize);
-            std::streamsize bytesRead = file.gcount();
+            std::string_view buffer = ingestion.GetHeader();
+            size_t bytesRead = buffer.size();
 
             // If the file is empty, ignore it
             if (bytesRead == 0)
@@ -266,7 +269,7 @@ namespace AIAssistant
             }
 
             size_t nonTextCount = 0;
-            for (std::streamsize i = 0; i < bytesRead; ++i)
+            for (size_t i = 0; i < bytesRead; ++i)
             {
                 unsigned char c = static_cast<unsigned char>(buffer[i]);
                 // Allow printable ASCII + common whitespace (tab/newline/carriage return)
@@ -287,12 +290,12 @@ namespace AIAssistant
 
         // --- Hard limit for oversized files ---
         {
-            std::error_code errorCode;
-            auto fileSize = fs::file_size(filePath, errorCode);
+            auto fileSize = ingestion.GetFileStat().m_Size;
 
             size_t fileSizeLimit = Core::g_Core->GetConfig().m_MaxFileSizekB;
 
-            if (!errorCode && fileSize > fileSizeLimit * 1024)
+            // Markdown documents are split into chunks of that size and sent chunk by chunk
+            if (ingestion.IsValid() && (fileSize > fileSizeLimit * 1024) && !MarkdownChunker::IsMarkdown(filePath))
             {
                 // Create .output.txt message
                 fs::path outputPath = filePath;
@@ -74,10 +74,11 @@ namespace AIAssistant
         fs::path const ModifyFile(fs::path const& filePath);
 
         CategorizedFiles& GetCategorizedFiles() { return m_CategorizedFiles; }
+        CategorizedFiles const& GetCategorizedFiles() const { return m_CategorizedFiles; }
         void PrintCategorizedFiles() const;
 
     private:
-        FileCategory Categorize(fs::path const& filePath) const;
+        FileCategory Categorize(fs::path const& filePath, FileIngestion& ingestion) const;
         void RemoveFromFiles(TrackedFiles& files, fs::path const& path);
 
         CategorizedFiles m_CategorizedFiles;
@@ -0,0 +1,148 @@
+/* Copyright (c) 2025 JC Technolabs
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+#include <algorithm>
+#include <vector>
+
+#include "core.h"
+#include "engine.h"
+#include "event/events.h"
+#include "file/fileEventCoalescer.h"
+
+namespace AIAssistant
+{
+    FileEventCoalescer::FileEventCoalescer(std::chrono::milliseconds debounce) : m_Debounce(debounce) {}
+
+    void FileEventCoalescer::Record(std::string const& path, Kind kind)
+    {
+        ++m_RawEvents;
+        auto const now = Clock::now();
+
+        auto [iterator, inserted] = m_Pending.try_emplace(path);
+        PendingFile& pendingFile = iterator->second;
+        if (inserted)
+        {
+            pendingFile.m_ExistedBefore = (kind != Kind::Added);
+            pendingFile.m_Sequence = m_NextSequence++;
+            pendingFile.m_FirstSeen = now;
+        }
+
+        pendingFile.m_ExistsNow = (kind != Kind::Removed);
+        pendingFile.m_LastSeen = now;
+        ++pendingFile.m_RawEvents;
+
+        if (pendingFile.m_ExistsNow)
+        {
+            std::error_code errorCode;
+            pendingFile.m_Size = fs::file_size(path, errorCode);
+            pendingFile.m_LastWriteTime = fs::last_write_time(path, errorCode);
+        }
+    }
+
+    bool FileEventCoalescer::IsStable(std::string const& path, PendingFile& pendingFile)
+    {
+        std::error_code sizeError;
+        std::error_code timeError;
+        uintmax_t const size = fs::file_size(path, sizeError);
+        fs::file_time_type const lastWriteTime = fs::last_write_time(path, timeError);
+        if (sizeError || timeError)
+        {
+            return false; // gone, the watcher will report the removal
+        }
+
+        if ((size != pendingFile.m_Size) || (lastWriteTime != pendingFile.m_LastWriteTime))
+        {
+            // still being written, wait for another debounce window
+            pendingFile.m_Size = size;
+            pendingFile.m_LastWriteTime = lastWriteTime;
+            pendingFile.m_LastSeen = Clock::now();
+            return false;
+        }
+        return true;
+    }
+
+    void FileEventCoalescer::Flush(bool force)
+    {
+        if (m_Pending.empty())
+        {
+            return;
+        }
+
+        auto const now = Clock::now();
+        std::vector<std::pair<uint64_t, EventQueue::EventPtr>> settledEvents;
+
+        for (auto iterator = m_Pending.begin(); iterator != m_Pending.end();)
+        {
+            auto& [path, pendingFile] = *iterator;
+
+            bool settled = force || ((now - pendingFile.m_FirstSeen) >= MAX_SETTLE_TIME);
+            if (!settled && ((now - pendingFile.m_LastSeen) >= m_Debounce))
+            {
+                settled = !pendingFile.m_ExistsNow || IsStable(path, pendingFile);
+            }
+
+            if (!settled)
+            {
+                ++iterator;
+                continue;
+            }
+
+            // net effect of everything recorded for this path:
+            // added + modified -> added, added + removed -> nothing,
+            // modified + removed -> removed, removed + added -> modified
+            EventQueue::EventPtr event;
+            if (pendingFile.m_ExistedBefore && pendingFile.m_ExistsNow)
+            {
+                event = EventPool::Create<FileModifiedEvent>(path);
+            }
+            else if (pendingFile.m_ExistsNow)
+            {
+                event = EventPool::Create<FileAddedEvent>(path);
+            }
+            else if (pendingFile.m_ExistedBefore)
+            {
+                event = EventPool::Create<FileRemovedEvent>(path);
+            }
+
+            uint32_t const emitted = event ? 1 : 0;
+            m_EmittedEvents += emitted;
+            m_SuppressedEvents += pendingFile.m_RawEvents - emitted;
+            if (event)
+            {
+                settledEvents.emplace_back(pendingFile.m_Sequence, std::move(event));
+            }
+            iterator = m_Pending.erase(iterator);
+        }
+
+        // keep the order in which files were first seen
+        std::sort(settledEvents.begin(), settledEvents.end(),
+                  [](auto const& lhs, auto const& rhs) { return lhs.first < rhs.first; });
+        for (auto& [sequence, event] : settledEvents)
+        {
+            Core::g_Core->PushEvent(std::move(event));
+        }
+    }
+
+    FileEventCoalescer::Statistics FileEventCoalescer::GetStatistics() const
+    {
+        return Statistics{m_RawEvents.load(), m_EmittedEvents.load(), m_SuppressedEvents.load()};
+    }
+} // namespace AIAssistant
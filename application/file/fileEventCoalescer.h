@@ -0,0 +1,99 @@
+/* Copyright (c) 2025 JC Technolabs
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+
+namespace fs = std::filesystem;
+
+namespace AIAssistant
+{
+    // Sits between the file watcher and the event queue. Raw add/modify/remove
+    // notifications are collected per path and only forwarded once the file
+    // has settled: no new notification for one debounce window and size and
+    // mtime unchanged since the last one. A burst of notifications for one
+    // path results in at most one Added, Modified or Removed event.
+    // Not thread-safe, owned by the watcher task (statistics excepted).
+    class FileEventCoalescer
+    {
+    public:
+        enum class Kind
+        {
+            Added,
+            Modified,
+            Removed
+        };
+
+        struct Statistics
+        {
+            uint64_t m_RawEvents{0};
+            uint64_t m_EmittedEvents{0};
+            uint64_t m_SuppressedEvents{0};
+        };
+
+    public:
+        explicit FileEventCoalescer(std::chrono::milliseconds debounce);
+
+        void Record(std::string const& path, Kind kind);
+
+        // forwards all settled files to the event queue, force flushes everything pending
+        void Flush(bool force = false);
+
+        bool HasPending() const { return !m_Pending.empty(); }
+        std::chrono::milliseconds GetDebounce() const { return m_Debounce; }
+        Statistics GetStatistics() const;
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct PendingFile
+        {
+            bool m_ExistedBefore{false}; // as far as the event queue knows
+            bool m_ExistsNow{false};
+            uint32_t m_RawEvents{0};
+            uint64_t m_Sequence{0};
+            Clock::time_point m_FirstSeen;
+            Clock::time_point m_LastSeen;
+            uintmax_t m_Size{0};
+            fs::file_time_type m_LastWriteTime{};
+        };
+
+        // returns true if size and mtime still match the last observation
+        bool IsStable(std::string const& path, PendingFile& pendingFile);
+
+    private:
+        // a file that is written continuously is forwarded after this time anyway
+        static constexpr std::chrono::milliseconds MAX_SETTLE_TIME{5000};
+
+        std::chrono::milliseconds m_Debounce;
+        std::unordered_map<std::string, PendingFile> m_Pending;
+        uint64_t m_NextSequence{0};
+
+        std::atomic<uint64_t> m_RawEvents{0};
+        std::atomic<uint64_t> m_EmittedEvents{0};
+        std::atomic<uint64_t> m_SuppressedEvents{0};
+    };
+} // namespace AIAssistant
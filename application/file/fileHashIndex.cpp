@@ -0,0 +1,329 @@
+/* Copyright (c) 2025 JC Technolabs
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#include "engine.h"
+#include "file/fileHashIndex.h"
+
+namespace AIAssistant
+{
+    // --- binary format helpers ---
+    // file: magic | version (u32) | hash algorithm (u8) | entry count (u64) | entries
+    // entry: path length (u32) | path | size (u64) | mtime (i64) | inode (u64) | 3x (digest size (u8) | digest)
+    static constexpr size_t MIN_ENTRY_SIZE = sizeof(uint32_t) + 3 * sizeof(uint64_t) + 3 * sizeof(uint8_t);
+
+    template <typename T>
+    static void AppendValue(std::string& buffer, T value)
+    {
+        buffer.append(reinterpret_cast<char const*>(&value), sizeof(T));
+    }
+
+    static void AppendHash(std::string& buffer, EngineCore::Digest const& hash)
+    {
+        AppendValue(buffer, hash.m_Size);
+        buffer.append(reinterpret_cast<char const*>(hash.m_Bytes.data()), hash.m_Size);
+    }
+
+    class IndexReader
+    {
+    public:
+        IndexReader(std::vector<char> const& data) : m_Data(data) {}
+
+        template <typename T>
+        bool Read(T& value)
+        {
+            if (m_Position + sizeof(T) > m_Data.size())
+            {
+                return false;
+            }
+            std::memcpy(&value, m_Data.data() + m_Position, sizeof(T));
+            m_Position += sizeof(T);
+            return true;
+        }
+
+        bool Read(std::string& text, size_t length)
+        {
+            if (m_Position + length > m_Data.size())
+            {
+                return false;
+            }
+            text.assign(m_Data.data() + m_Position, length);
+            m_Position += length;
+            return true;
+        }
+
+        bool ReadHash(EngineCore::Digest& hash)
+        {
+            if (!Read(hash.m_Size) || (hash.m_Size > hash.m_Bytes.size()) || (m_Position + hash.m_Size > m_Data.size()))
+            {
+                return false;
+            }
+            std::memcpy(hash.m_Bytes.data(), m_Data.data() + m_Position, hash.m_Size);
+            m_Position += hash.m_Size;
+            return true;
+        }
+
+        size_t GetRemaining() const { return m_Data.size() - m_Position; }
+
+    private:
+        std::vector<char> const& m_Data;
+        size_t m_Position{0};
+    };
+
+    FileHashIndex& FileHashIndex::Get()
+    {
+        static FileHashIndex instance;
+        return instance;
+    }
+
+    bool FileHashIndex::Load(fs::path const& indexFilepath)
+    {
+        std::lock_guard lock(m_Mutex);
+        m_IndexFilepath = indexFilepath;
+        m_Entries.clear();
+        m_Dirty = false;
+
+        std::ifstream file(indexFilepath, std::ios::binary);
+        if (!file)
+        {
+            LOG_APP_INFO("FileHashIndex: no index found at '{}', starting empty", indexFilepath.string());
+            return false;
+        }
+        std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+        IndexReader reader(data);
+        char magic[sizeof(MAGIC)]{};
+        uint32_t version{0};
+        uint8_t hashAlgorithm{0};
+        uint64_t entryCount{0};
+        bool ok = reader.Read(magic) && (std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0) && reader.Read(version) &&
+                  (version == VERSION) && reader.Read(hashAlgorithm) && reader.Read(entryCount);
+        if (!ok)
+        {
+            LOG_APP_WARN("FileHashIndex: ignoring index '{}' (unknown format or version)", indexFilepath.string());
+            return false;
+        }
+        if (hashAlgorithm != static_cast<uint8_t>(EngineCore::GetHashAlgorithm()))
+        {
+            LOG_APP_INFO("FileHashIndex: hash algorithm changed, ignoring index '{}'", indexFilepath.string());
+            return false;
+        }
+
+        // a corrupted count must not reserve more than the file can hold
+        if (entryCount > reader.GetRemaining() / MIN_ENTRY_SIZE)
+        {
+            LOG_APP_WARN("FileHashIndex: ignoring index '{}' (entry count {} does not fit the file)",
+                         indexFilepath.string(), entryCount);
+            return false;
+        }
+        m_Entries.reserve(entryCount);
+        for (uint64_t index = 0; index < entryCount; ++index)
+        {
+            uint32_t pathLength{0};
+            std::string path;
+            Entry entry;
+            ok = reader.Read(pathLength) && reader.Read(path, pathLength) && reader.Read(entry.m_FileStat.m_Size) &&
+                 reader.Read(entry.m_FileStat.m_LastWriteTime) && reader.Read(entry.m_FileStat.m_Inode) &&
+                 reader.ReadHash(entry.m_Hash) && reader.ReadHash(entry.m_InputHash) &&
+                 reader.ReadHash(entry.m_EnvironmentHash);
+            if (!ok)
+            {
+                LOG_APP_WARN("FileHashIndex: index '{}' is truncated, starting empty", indexFilepath.string());
+                m_Entries.clear();
+                return false;
+            }
+            m_Entries[std::move(path)] = std::move(entry);
+        }
+
+        LOG_APP_INFO("FileHashIndex: loaded {} entries from '{}'", m_Entries.size(), indexFilepath.string());
+        return true;
+    }
+
+    bool FileHashIndex::Save(bool pruneMissingFiles)
+    {
+        std::lock_guard lock(m_Mutex);
+        if (m_IndexFilepath.empty())
+        {
+            return false;
+        }
+
+        if (pruneMissingFiles)
+        {
+            std::erase_if(m_Entries,
+                          [](auto const& element)
+                          {
+                              std::error_code errorCode;
+                              return !fs::exists(element.first, errorCode);
+                          });
+        }
+
+        std::string buffer;
+        buffer.reserve(16 + m_Entries.size() * 256);
+        buffer.append(MAGIC, sizeof(MAGIC));
+        AppendValue(buffer, VERSION);
+        AppendValue(buffer, static_cast<uint8_t>(EngineCore::GetHashAlgorithm()));
+        AppendValue(buffer, static_cast<uint64_t>(m_Entries.size()));
+        for (auto const& [path, entry] : m_Entries)
+        {
+            AppendValue(buffer, static_cast<uint32_t>(path.size()));
+            buffer.append(path);
+            AppendValue(buffer, entry.m_FileStat.m_Size);
+            AppendValue(buffer, entry.m_FileStat.m_LastWriteTime);
+            AppendValue(buffer, entry.m_FileStat.m_Inode);
+            AppendHash(buffer, entry.m_Hash);
+            AppendHash(buffer, entry.m_InputHash);
+            AppendHash(buffer, entry.m_EnvironmentHash);
+        }
+
+        // write to a temporary file and rename it, so a crash never leaves a half-written index
+        std::error_code errorCode;
+        fs::create_directories(m_IndexFilepath.parent_path(), errorCode);
+        fs::path temporaryFilepath = m_IndexFilepath;
+        temporaryFilepath += ".tmp";
+        {
+            std::ofstream out(temporaryFilepath, std::ios::binary | std::ios::trunc);
+            if (!out || !out.write(buffer.data(), static_cast<std::streamsize>(buffer.size())))
+            {
+                LOG_APP_ERROR("FileHashIndex: could not write '{}'", temporaryFilepath.string());
+                return false;
+            }
+        }
+        fs::rename(temporaryFilepath, m_IndexFilepath, errorCode);
+        if (errorCode)
+        {
+            LOG_APP_ERROR("FileHashIndex: could not replace '{}': {}", m_IndexFilepath.string(), errorCode.message());
+            return false;
+        }
+
+        m_Dirty = false;
+        return true;
+    }
+
+    bool FileHashIndex::IsDirty() const
+    {
+        std::lock_guard lock(m_Mutex);
+        return m_Dirty;
+    }
+
+    std::optional<EngineCore::Digest> FileHashIndex::Lookup(std::string const& path,
+                                                            EngineCore::FileStat const& fileStat) const
+    {
+        std::lock_guard lock(m_Mutex);
+        auto entry = m_Entries.find(path);
+        if ((entry == m_Entries.end()) || (entry->second.m_FileStat != fileStat) || entry->second.m_Hash.IsEmpty())
+        {
+            return std::nullopt;
+        }
+        return entry->second.m_Hash;
+    }
+
+    void FileHashIndex::Update(std::string const& path, EngineCore::FileStat const& fileStat,
+                               EngineCore::Digest const& hash)
+    {
+        std::lock_guard lock(m_Mutex);
+        Entry& entry = m_Entries[path];
+        if (entry.m_Hash != hash)
+        {
+            // an edited output is not the generated one anymore
+            entry.m_InputHash = {};
+            entry.m_EnvironmentHash = {};
+        }
+        entry.m_FileStat = fileStat;
+        entry.m_Hash = hash;
+        m_Dirty = true;
+    }
+
+    void FileHashIndex::Remove(std::string const& path)
+    {
+        std::lock_guard lock(m_Mutex);
+        if (m_Entries.erase(path) > 0)
+        {
+            m_Dirty = true;
+        }
+    }
+
+    void FileHashIndex::RecordOutput(EngineCore::Digest const& inputHash, EngineCore::Digest const& environmentHash,
+                                     fs::path const& outputPath)
+    {
+        EngineCore::FileStat outputStat;
+        EngineCore::Digest outputHash;
+        if (!EngineCore::GetFileStat(outputPath, outputStat) || !EngineCore::ComputeFileHash(outputPath, outputHash))
+        {
+            return;
+        }
+
+        // recorded even if the input changed while the query was in flight:
+        // its hash won't match anymore and the requirement is queried again
+        std::lock_guard lock(m_Mutex);
+        Entry& output = m_Entries[outputPath.string()];
+        output.m_FileStat = outputStat;
+        output.m_Hash = outputHash;
+        output.m_InputHash = inputHash;
+        output.m_EnvironmentHash = environmentHash;
+        m_Dirty = true;
+    }
+
+    std::optional<bool> FileHashIndex::IsOutputUpToDate(EngineCore::Digest const& inputHash,
+                                                        EngineCore::Digest const& environmentHash,
+                                                        fs::path const& outputPath)
+    {
+        Entry recorded;
+        {
+            std::lock_guard lock(m_Mutex);
+            auto output = m_Entries.find(outputPath.string());
+            if ((output == m_Entries.end()) || output->second.m_InputHash.IsEmpty())
+            {
+                return std::nullopt;
+            }
+            recorded = output->second;
+        }
+
+        EngineCore::FileStat outputStat;
+        if (!EngineCore::GetFileStat(outputPath, outputStat))
+        {
+            return false; // output was deleted
+        }
+        if (recorded.m_FileStat != outputStat)
+        {
+            // touched or restored, or edited: only the content tells
+            EngineCore::Digest outputHash;
+            if (!EngineCore::ComputeFileHash(outputPath, outputHash) || (outputHash != recorded.m_Hash))
+            {
+                return std::nullopt; // edited after it was generated, let timestamps decide
+            }
+
+            // same content: remember the new stat, unless the output was recorded again meanwhile
+            std::lock_guard lock(m_Mutex);
+            auto output = m_Entries.find(outputPath.string());
+            if ((output != m_Entries.end()) && (output->second.m_Hash == recorded.m_Hash) &&
+                (output->second.m_FileStat == recorded.m_FileStat))
+            {
+                output->second.m_FileStat = outputStat;
+                m_Dirty = true;
+            }
+        }
+
+        return (recorded.m_InputHash == inputHash) && (recorded.m_EnvironmentHash == environmentHash);
+    }
+} // namespace AIAssistant
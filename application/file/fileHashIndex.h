@@ -0,0 +1,94 @@
+/* Copyright (c) 2025 JC Technolabs
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+#pragma once
+
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include "auxiliary/file.h"
+#include "auxiliary/hash.h"
+
+namespace fs = std::filesystem;
+
+namespace AIAssistant
+{
+    // Persistent path -> (stat, content hash, input hash, environment hash) index.
+    // Lets a restart recognise unchanged files with a single stat instead of
+    // re-hashing them. Every output records the input content and the environment
+    // fingerprint it was generated from, so whether a requirement needs a query is
+    // decided by comparing hashes, not timestamps. An input restored to earlier
+    // content (e.g. by git) matches its output again.
+    // Stored in a compact binary format in the hidden state folder of the queue.
+    class FileHashIndex
+    {
+    public:
+        struct Entry
+        {
+            EngineCore::FileStat m_FileStat;
+            EngineCore::Digest m_Hash;
+            // outputs only, empty for other files and for outputs edited since they were generated
+            EngineCore::Digest m_InputHash;       // content of the input this output was generated from
+            EngineCore::Digest m_EnvironmentHash; // environment fingerprint it was generated with
+        };
+
+    public:
+        static FileHashIndex& Get();
+
+        bool Load(fs::path const& indexFilepath);
+        bool Save(bool pruneMissingFiles = false);
+        bool IsDirty() const;
+
+        // returns the stored hash if the file's stat still matches
+        std::optional<EngineCore::Digest> Lookup(std::string const& path, EngineCore::FileStat const& fileStat) const;
+        void Update(std::string const& path, EngineCore::FileStat const& fileStat, EngineCore::Digest const& hash);
+        void Remove(std::string const& path);
+
+        // called after an output file was written from input content with inputHash
+        void RecordOutput(EngineCore::Digest const& inputHash, EngineCore::Digest const& environmentHash,
+                          fs::path const& outputPath);
+
+        // no value: nothing recorded (output from an older version, or edited), caller decides by timestamps
+        // true: the output exists and was generated from exactly this input content and environment
+        // an output that was touched but not changed gets its new stat recorded, it is hashed once
+        std::optional<bool> IsOutputUpToDate(EngineCore::Digest const& inputHash,
+                                             EngineCore::Digest const& environmentHash, fs::path const& outputPath);
+
+    private:
+        FileHashIndex() = default;
+        ~FileHashIndex() = default;
+
+        FileHashIndex(const FileHashIndex&) = delete;
+        FileHashIndex& operator=(const FileHashIndex&) = delete;
+
+    private:
+        static constexpr char MAGIC[4] = {'J', 'A', 'I', 'X'};
+        static constexpr uint32_t VERSION = 3;
+
+        fs::path m_IndexFilepath;
+        std::unordered_map<std::string, Entry> m_Entries;
+        bool m_Dirty{false};
+        mutable std::mutex m_Mutex;
+    };
+} // namespace AIAssistant
@@ -0,0 +1,127 @@
+/* Copyright (c) 2025 JC Technolabs
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+#include <memory>
+
+#include "engine.h"
+#include "file/fileIngestion.h"
+#include "file/fileHashIndex.h"
+
+namespace AIAssistant
+{
+    FileIngestion::FileIngestion(fs::path const& path) : m_Path(path)
+    {
+        m_Valid = EngineCore::GetFileStat(m_Path, m_FileStat);
+    }
+
+    void FileIngestion::Read()
+    {
+        if (m_Read)
+        {
+            return;
+        }
+        m_Read = true;
+
+        if (!m_Valid)
+        {
+            return;
+        }
+
+        EngineCore::FilePtr file = EngineCore::OpenFileForReading(m_Path);
+        if (!file)
+        {
+            return;
+        }
+        m_Readable = true;
+
+        std::optional<EngineCore::Digest> storedHash = FileHashIndex::Get().Lookup(m_Path.string(), m_FileStat);
+        size_t const maxContentSize = Core::g_Core->GetConfig().m_MaxFileSizekB * 1024;
+
+        if (!storedHash.has_value() && (m_FileStat.m_Size <= maxContentSize))
+        {
+            // read it all, one buffer serves everything
+            m_Content.resize(m_FileStat.m_Size);
+            size_t bytesRead = std::fread(m_Content.data(), 1, m_Content.size(), file.get());
+            m_Content.resize(bytesRead);
+            m_HasContent = true;
+            m_Hash = EngineCore::ComputeHash(m_Content);
+            return;
+        }
+
+        // header sample only
+        m_Content.resize(HEADER_SIZE);
+        size_t bytesRead = std::fread(m_Content.data(), 1, m_Content.size(), file.get());
+        m_Content.resize(bytesRead);
+
+        if (storedHash.has_value())
+        {
+            m_Hash = storedHash.value();
+            m_HashFromIndex = true;
+        }
+        else
+        {
+            // too large to keep, stream the rest into the hash
+            EngineCore::Hasher hasher(EngineCore::GetHashAlgorithm());
+            hasher.Update(m_Content.data(), m_Content.size());
+            if (hasher.UpdateFromFile(file.get()))
+            {
+                m_Hash = hasher.Finalize();
+            }
+        }
+    }
+
+    bool FileIngestion::IsReadable()
+    {
+        Read();
+        return m_Readable;
+    }
+
+    std::string_view FileIngestion::GetHeader()
+    {
+        Read();
+        return std::string_view(m_Content).substr(0, HEADER_SIZE);
+    }
+
+    EngineCore::Digest const& FileIngestion::GetHash()
+    {
+        Read();
+        return m_Hash;
+    }
+
+    bool FileIngestion::IsHashFromIndex()
+    {
+        Read();
+        return m_HashFromIndex;
+    }
+
+    bool FileIngestion::HasContent()
+    {
+        Read();
+        return m_HasContent;
+    }
+
+    std::string FileIngestion::TakeContent()
+    {
+        Read();
+        m_HasContent = false;
+        return std::move(m_Content);
+    }
+} // namespace AIAssistant
@@ -0,0 +1,75 @@
+/* Copyright (c) 2025 JC Technolabs
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+#include "auxiliary/file.h"
+#include "auxiliary/hash.h"
+
+namespace fs = std::filesystem;
+
+namespace AIAssistant
+{
+    // One version of a file on disk. Stats it on construction and reads it at
+    // most once, on first use: files within the max file size are read in full
+    // and header sniffing, hashing and the prompt content all use that buffer.
+    // Larger files only get a header sample, the rest is streamed into the hash.
+    // If the index already knows the file's stat, the stored hash is used and
+    // only the header is read.
+    class FileIngestion
+    {
+    public:
+        explicit FileIngestion(fs::path const& path);
+
+        bool IsValid() const { return m_Valid; } // stat succeeded
+        EngineCore::FileStat const& GetFileStat() const { return m_FileStat; }
+
+        bool IsReadable();
+        std::string_view GetHeader(); // first HEADER_SIZE bytes at most
+        EngineCore::Digest const& GetHash();
+        bool IsHashFromIndex();
+
+        bool HasContent();
+        std::string TakeContent(); // invalidates GetHeader()
+
+    public:
+        static constexpr size_t HEADER_SIZE = 256;
+
+    private:
+        void Read();
+
+    private:
+        fs::path m_Path;
+        EngineCore::FileStat m_FileStat;
+        bool m_Valid{false};
+
+        bool m_Read{false};
+        bool m_Readable{false};
+        bool m_HasContent{false};
+        bool m_HashFromIndex{false};
+        std::string m_Content; // complete file or header sample
+        EngineCore::Digest m_Hash;
+    };
+} // namespace AIAssistant
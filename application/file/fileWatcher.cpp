@@ -26,10 +26,18 @@
 #include "file/fileWatcher.h"
 #include "event/events.h"
 
+#ifdef __linux__
+#include <poll.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
 namespace AIAssistant
 {
     FileWatcher::FileWatcher(const fs::path& pathToWatch, std::chrono::milliseconds interval)
-        : m_PathToWatch(pathToWatch), m_Interval(interval)
+        : m_PathToWatch(pathToWatch), m_Interval(interval),
+          m_Coalescer(Core::g_Core->GetConfig().m_FileWatcherDebounce)
     {
     }
 
@@ -43,21 +51,27 @@ namespace AIAssistant
         }
 
         m_Running = true;
-        // Submit watcher to the thread pool
-        m_WatchTask = Core::g_Core->GetThreadPool().SubmitTask([this]() { Watch(); });
+        // the watcher blocks in its loop, it gets a service thread rather than a pool worker
+        m_WatchTask = Core::g_Core->GetThreadPool().StartService("file watcher", [this]() { Watch(); });
     }
 
     bool FileWatcher::IsValidFile(fs::directory_entry const& entry)
     {
-        if (!fs::is_regular_file(entry))
+        std::error_code errorCode;
+        if (!entry.is_regular_file(errorCode))
         {
             return false;
         }
 
         // exclude files that start with a dot
         // geany does that for temp files in the current folder
-        auto filename = entry.path().filename().string();
-        return !(!filename.empty() && filename[0] == '.');
+        return !IsHidden(entry.path());
+    }
+
+    bool FileWatcher::IsHidden(fs::path const& path)
+    {
+        auto filename = path.filename().string();
+        return !filename.empty() && filename[0] == '.';
     }
 
     void FileWatcher::Stop()
@@ -71,28 +85,36 @@ namespace AIAssistant
         if (m_WatchTask.valid())
         {
             m_WatchTask.wait(); // wait for graceful exit
-            LOG_APP_INFO("File watcher stopped");
+            auto statistics = m_Coalescer.GetStatistics();
+            LOG_APP_INFO("File watcher stopped ({} raw file events, {} forwarded, {} suppressed)", statistics.m_RawEvents,
+                         statistics.m_EmittedEvents, statistics.m_SuppressedEvents);
         }
     }
 
     void FileWatcher::Watch()
     {
-        std::unordered_map<std::string, fs::file_time_type> files;
-
-        // --- Initial scan ---
-        for (auto& file : fs::recursive_directory_iterator(m_PathToWatch))
+#ifdef __linux__
+        if (Core::g_Core->GetConfig().m_FileWatcher == ConfigParser::EngineConfig::FileWatcherType::Inotify)
         {
-            if (!IsValidFile(file))
+            if (WatchInotify())
             {
-                continue;
+                m_Coalescer.Flush(true);
+                return;
             }
+            LOG_APP_WARN("inotify not available for '{}', falling back to polling", m_PathToWatch.string());
+        }
+#endif
+        WatchPolling();
+    }
 
-            std::string const pathStr = file.path().string();
-            files[pathStr] = fs::last_write_time(file);
+    void FileWatcher::WatchPolling()
+    {
+        LOG_APP_INFO("file watcher: polling '{}' every {} ms", m_PathToWatch.string(), m_Interval.count());
 
-            // fire event for existing files at startup
-            Core::g_Core->PushEvent(std::make_shared<FileAddedEvent>(pathStr));
-        }
+        // --- Initial scan ---
+        // fires events for existing files at startup,
+        // files already known from a failed inotify attempt are not reported twice
+        ScanDirectory(m_PathToWatch);
 
         while (m_Running)
         {
@@ -101,46 +123,304 @@ namespace AIAssistant
             if (!EngineCore::FileExists(m_PathToWatch))
             {
                 LOG_APP_INFO("folder '{}' no longer exists, requesting shutdown", m_PathToWatch.string());
-                auto event = std::make_shared<EngineEvent>(EngineEvent::EngineEventShutdown);
+                auto event = EventPool::Create<EngineEvent>(EngineEvent::EngineEventShutdown);
                 Core::g_Core->PushEvent(event);
+                continue;
             }
 
-            // Detect added or modified files
-            for (auto& file : fs::recursive_directory_iterator(m_PathToWatch))
+            ScanDirectory(m_PathToWatch);
+            RemoveMissingFiles();
+            m_Coalescer.Flush();
+        }
+        m_Coalescer.Flush(true);
+    }
+
+    void FileWatcher::ScanDirectory(fs::path const& directory)
+    {
+        std::error_code errorCode;
+        auto iterator =
+            fs::recursive_directory_iterator(directory, fs::directory_options::skip_permission_denied, errorCode);
+        for (; !errorCode && (iterator != fs::recursive_directory_iterator()); iterator.increment(errorCode))
+        {
+            fs::directory_entry const& entry = *iterator;
+
+            std::error_code entryError;
+            if (entry.is_directory(entryError))
             {
-                if (!IsValidFile(file))
+                // hidden folders hold tool state (.git, .jarvis, ...), not queries
+                if (IsHidden(entry.path()))
                 {
-                    continue;
+                    iterator.disable_recursion_pending();
                 }
-
-                fs::file_time_type const currentTime = fs::last_write_time(file);
-                std::string const pathStr = file.path().string();
-
-                if (!files.contains(pathStr))
+#ifdef __linux__
+                else if (m_InotifyFd >= 0)
                 {
-                    Core::g_Core->PushEvent(std::make_shared<FileAddedEvent>(pathStr));
-                    files[pathStr] = currentTime;
+                    AddWatch(entry.path());
                 }
-                else if (files[pathStr] != currentTime)
+#endif
+                continue;
+            }
+
+            if (IsValidFile(entry))
+            {
+                CheckFile(entry.path().string());
+            }
+        }
+    }
+
+    void FileWatcher::CheckFile(std::string const& pathStr)
+    {
+        std::error_code errorCode;
+        if (!fs::is_regular_file(pathStr, errorCode))
+        {
+            return;
+        }
+
+        fs::file_time_type const currentTime = fs::last_write_time(pathStr, errorCode);
+        if (errorCode)
+        {
+            return; // removed in the meantime
+        }
+
+        auto file = m_Files.find(pathStr);
+        if (file == m_Files.end())
+        {
+            m_Files.emplace(pathStr, currentTime);
+            m_Coalescer.Record(pathStr, FileEventCoalescer::Kind::Added);
+        }
+        else if (file->second != currentTime)
+        {
+            file->second = currentTime;
+            m_Coalescer.Record(pathStr, FileEventCoalescer::Kind::Modified);
+        }
+    }
+
+    void FileWatcher::RemoveMissingFiles()
+    {
+        for (auto it = m_Files.begin(); it != m_Files.end();)
+        {
+            std::error_code errorCode;
+            if (!fs::exists(it->first, errorCode))
+            {
+                m_Coalescer.Record(it->first, FileEventCoalescer::Kind::Removed);
+                it = m_Files.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    void FileWatcher::RemoveFilesBelow(std::string const& directory)
+    {
+        std::string const prefix = directory + static_cast<char>(fs::path::preferred_separator);
+        for (auto it = m_Files.begin(); it != m_Files.end();)
+        {
+            if (it->first.starts_with(prefix))
+            {
+                m_Coalescer.Record(it->first, FileEventCoalescer::Kind::Removed);
+                it = m_Files.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+#ifdef __linux__
+    bool FileWatcher::WatchInotify()
+    {
+        m_InotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (m_InotifyFd < 0)
+        {
+            LOG_APP_WARN("inotify_init1 failed: {}", std::strerror(errno));
+            return false;
+        }
+
+        // watches are registered while scanning, before a folder's files are visited,
+        // so nothing created during the initial scan is missed
+        m_InotifyFailed = false;
+        m_RootWatchDescriptor = AddWatch(m_PathToWatch);
+        if (m_RootWatchDescriptor >= 0)
+        {
+            ScanDirectory(m_PathToWatch);
+        }
+        else
+        {
+            m_InotifyFailed = true;
+        }
+
+        if (!m_InotifyFailed)
+        {
+            LOG_APP_INFO("file watcher: inotify on '{}' ({} folders)", m_PathToWatch.string(), m_WatchDescriptors.size());
+        }
+
+        alignas(inotify_event) char buffer[64 * 1024];
+        while (m_Running && !m_InotifyFailed)
+        {
+            // the timeout bounds how long Stop() waits for us
+            // and how late pending files are forwarded by the coalescer
+            auto timeout = m_Coalescer.HasPending() ? std::min(m_Interval, m_Coalescer.GetDebounce()) : m_Interval;
+            pollfd pollDescriptor{m_InotifyFd, POLLIN, 0};
+            int ready = ::poll(&pollDescriptor, 1, static_cast<int>(timeout.count()));
+            if (ready < 0)
+            {
+                if (errno == EINTR)
                 {
-                    Core::g_Core->PushEvent(std::make_shared<FileModifiedEvent>(pathStr));
-                    files[pathStr] = currentTime;
+                    continue;
                 }
+                LOG_APP_ERROR("poll on inotify descriptor failed: {}", std::strerror(errno));
+                m_InotifyFailed = true;
+                break;
             }
 
-            // Detect removed files
-            for (auto it = files.begin(); it != files.end();)
+            // drain everything the kernel has queued
+            while (ready > 0)
             {
-                if (!fs::exists(it->first))
+                ssize_t length = ::read(m_InotifyFd, buffer, sizeof(buffer));
+                if (length <= 0)
                 {
-                    Core::g_Core->PushEvent(std::make_shared<FileRemovedEvent>(it->first));
-                    it = files.erase(it);
+                    break;
                 }
-                else
+
+                for (char const* ptr = buffer; ptr < buffer + length;)
                 {
-                    ++it;
+                    auto const& event = *reinterpret_cast<inotify_event const*>(ptr);
+                    HandleInotifyEvent(event);
+                    ptr += sizeof(inotify_event) + event.len;
                 }
             }
+            m_Coalescer.Flush();
+        }
+
+        ::close(m_InotifyFd);
+        m_InotifyFd = -1;
+        m_RootWatchDescriptor = -1;
+        m_WatchDescriptors.clear();
+
+        return !m_InotifyFailed;
+    }
+
+    int FileWatcher::AddWatch(fs::path const& directory)
+    {
+        constexpr uint32_t mask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_CREATE | IN_DELETE | IN_ATTRIB |
+                                  IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR;
+
+        int watchDescriptor = inotify_add_watch(m_InotifyFd, directory.c_str(), mask);
+        if (watchDescriptor < 0)
+        {
+            if (errno == ENOSPC)
+            {
+                LOG_APP_WARN("inotify watch limit reached at '{}' (see /proc/sys/fs/inotify/max_user_watches)",
+                             directory.string());
+                m_InotifyFailed = true;
+            }
+            else
+            {
+                // the folder may have been removed in the meantime
+                LOG_APP_WARN("could not watch folder '{}': {}", directory.string(), std::strerror(errno));
+            }
+            return watchDescriptor;
+        }
+
+        m_WatchDescriptors[watchDescriptor] = directory.string();
+        return watchDescriptor;
+    }
+
+    void FileWatcher::RemoveWatchesBelow(std::string const& directory)
+    {
+        std::string const prefix = directory + static_cast<char>(fs::path::preferred_separator);
+        for (auto it = m_WatchDescriptors.begin(); it != m_WatchDescriptors.end();)
+        {
+            if ((it->second == directory) || it->second.starts_with(prefix))
+            {
+                inotify_rm_watch(m_InotifyFd, it->first);
+                it = m_WatchDescriptors.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    void FileWatcher::HandleInotifyEvent(inotify_event const& event)
+    {
+        if (event.mask & IN_Q_OVERFLOW)
+        {
+            // the kernel dropped events, recover with a full rescan
+            LOG_APP_WARN("inotify queue overflow, rescanning '{}'", m_PathToWatch.string());
+            ScanDirectory(m_PathToWatch);
+            RemoveMissingFiles();
+            return;
+        }
+
+        auto watch = m_WatchDescriptors.find(event.wd);
+        if (watch == m_WatchDescriptors.end())
+        {
+            return; // already removed
+        }
+
+        if (event.mask & IN_IGNORED)
+        {
+            m_WatchDescriptors.erase(watch);
+            return;
+        }
+
+        if ((event.wd == m_RootWatchDescriptor) && (event.mask & (IN_DELETE_SELF | IN_MOVE_SELF)))
+        {
+            LOG_APP_INFO("folder '{}' no longer exists, requesting shutdown", m_PathToWatch.string());
+            auto shutdownEvent = EventPool::Create<EngineEvent>(EngineEvent::EngineEventShutdown);
+            Core::g_Core->PushEvent(shutdownEvent);
+            return;
+        }
+
+        if (event.len == 0)
+        {
+            return; // event on the watched folder itself
+        }
+
+        std::string_view name(event.name);
+        if (name.empty() || (name[0] == '.'))
+        {
+            return; // hidden files and folders are ignored
+        }
+
+        std::string const pathStr = (fs::path(watch->second) / name).string();
+
+        if (event.mask & IN_ISDIR)
+        {
+            if (event.mask & (IN_CREATE | IN_MOVED_TO))
+            {
+                // watch the new folder, then pick up files created before the watch was in place
+                if (AddWatch(pathStr) >= 0)
+                {
+                    ScanDirectory(pathStr);
+                }
+            }
+            else if (event.mask & (IN_DELETE | IN_MOVED_FROM))
+            {
+                RemoveWatchesBelow(pathStr);
+                RemoveFilesBelow(pathStr);
+            }
+            return;
+        }
+
+        if (event.mask & (IN_DELETE | IN_MOVED_FROM))
+        {
+            if (m_Files.erase(pathStr) > 0)
+            {
+                m_Coalescer.Record(pathStr, FileEventCoalescer::Kind::Removed);
+            }
+        }
+        else if (event.mask & (IN_CLOSE_WRITE | IN_MOVED_TO | IN_ATTRIB))
+        {
+            // IN_CREATE and IN_MODIFY are not handled for files: a file is reported
+            // once its writer closed it, not while it is still empty or half written
+            CheckFile(pathStr);
         }
     }
+#endif
 } // namespace AIAssistant
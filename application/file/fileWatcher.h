@@ -28,6 +28,11 @@
 #include "event/eventQueue.h"
 #include "event/filesystemEvent.h"
 #include "core.h"
+#include "file/fileEventCoalescer.h"
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#endif
 
 namespace fs = std::filesystem;
 
@@ -42,13 +47,42 @@ namespace AIAssistant
         void Start();
         void Stop();
 
+        FileEventCoalescer::Statistics GetStatistics() const { return m_Coalescer.GetStatistics(); }
+
     private:
         void Watch();
+        void WatchPolling();
         bool IsValidFile(fs::directory_entry const& entry);
+        static bool IsHidden(fs::path const& path);
+
+        // walks the tree below directory and reports new or changed files
+        void ScanDirectory(fs::path const& directory);
+        void CheckFile(std::string const& pathStr);
+        void RemoveMissingFiles();
+        void RemoveFilesBelow(std::string const& directory);
+
+#ifdef __linux__
+        // returns false if inotify is not usable, the caller then falls back to polling
+        bool WatchInotify();
+        int AddWatch(fs::path const& directory);
+        void RemoveWatchesBelow(std::string const& directory);
+        void HandleInotifyEvent(inotify_event const& event);
+#endif
 
         fs::path m_PathToWatch;
         std::chrono::milliseconds m_Interval;
         std::atomic<bool> m_Running{false};
         std::future<void> m_WatchTask;
+
+        // only accessed by the watcher task
+        std::unordered_map<std::string, fs::file_time_type> m_Files;
+        FileEventCoalescer m_Coalescer;
+
+#ifdef __linux__
+        int m_InotifyFd{-1};
+        int m_RootWatchDescriptor{-1};
+        bool m_InotifyFailed{false};
+        std::unordered_map<int, std::string> m_WatchDescriptors;
+#endif
     };
 } // namespace AIAssistant
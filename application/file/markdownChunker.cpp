@@ -0,0 +1,225 @@
+/* Copyright (c) 2025 JC Technolabs
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+#include <algorithm>
+#include <cctype>
+
+#include "file/markdownChunker.h"
+
+namespace AIAssistant
+{
+    namespace
+    {
+        constexpr std::string_view CHUNK_FOLDER_SUFFIX = "_chunks";
+
+        bool IsWhitespace(char character)
+        {
+            return (character == ' ') || (character == '\t') || (character == '\n') || (character == '\r') ||
+                   (character == '\f') || (character == '\v');
+        }
+
+        // "# title" to "###### title"
+        bool IsHeading(std::string_view line)
+        {
+            size_t level = 0;
+            while ((level < line.size()) && (line[level] == '#'))
+            {
+                ++level;
+            }
+            return (level >= 1) && (level <= 6) && (level < line.size()) && ((line[level] == ' ') || (line[level] == '\t'));
+        }
+
+        // from one heading to the next, the text before the first heading is a section too
+        template <typename Callback>
+        void ForEachSection(std::string_view text, Callback const& callback)
+        {
+            size_t sectionBegin = 0;
+            size_t lineBegin = 0;
+            while (lineBegin < text.size())
+            {
+                size_t lineEnd = text.find('\n', lineBegin);
+                lineEnd = (lineEnd == std::string_view::npos) ? text.size() : lineEnd + 1;
+                if ((lineBegin > sectionBegin) && IsHeading(text.substr(lineBegin, lineEnd - lineBegin)))
+                {
+                    callback(text.substr(sectionBegin, lineBegin - sectionBegin));
+                    sectionBegin = lineBegin;
+                }
+                lineBegin = lineEnd;
+            }
+            if (sectionBegin < text.size())
+            {
+                callback(text.substr(sectionBegin));
+            }
+        }
+
+        // a paragraph together with the blank lines that follow it
+        template <typename Callback>
+        void ForEachParagraph(std::string_view text, Callback const& callback)
+        {
+            size_t paragraphBegin = 0;
+            size_t position = text.find('\n');
+            while (position != std::string_view::npos)
+            {
+                // a paragraph break is a line break followed by whitespace with another line break in it
+                size_t end = position + 1;
+                size_t lastLineBreak = std::string_view::npos;
+                while ((end < text.size()) && IsWhitespace(text[end]))
+                {
+                    if (text[end] == '\n')
+                    {
+                        lastLineBreak = end;
+                    }
+                    ++end;
+                }
+                if (lastLineBreak != std::string_view::npos)
+                {
+                    callback(text.substr(paragraphBegin, lastLineBreak + 1 - paragraphBegin));
+                    paragraphBegin = lastLineBreak + 1;
+                }
+                position = text.find('\n', end);
+            }
+            if (paragraphBegin < text.size())
+            {
+                callback(text.substr(paragraphBegin));
+            }
+        }
+
+        // fixed-size pieces, never cutting through a multi-byte character
+        template <typename Callback>
+        void ForEachPiece(std::string_view text, size_t maxSize, Callback const& callback)
+        {
+            size_t begin = 0;
+            while (begin < text.size())
+            {
+                size_t end = std::min(begin + maxSize, text.size());
+                size_t cut = end;
+                // UTF-8 continuation bytes are 10xxxxxx
+                while ((cut > begin) && (cut < text.size()) && ((static_cast<unsigned char>(text[cut]) & 0xC0) == 0x80))
+                {
+                    --cut;
+                }
+                if (cut > begin)
+                {
+                    end = cut;
+                }
+                callback(text.substr(begin, end - begin));
+                begin = end;
+            }
+        }
+    } // namespace
+
+    std::vector<std::string_view> MarkdownChunker::Split(std::string_view markdown, size_t maxChunkSize)
+    {
+        std::vector<std::string_view> chunks;
+
+        // leading blank lines would only fill the first chunk
+        size_t contentBegin = markdown.find_first_not_of(" \t\n\r\f\v");
+        if (contentBegin == std::string_view::npos)
+        {
+            return chunks;
+        }
+        size_t lineBegin = markdown.rfind('\n', contentBegin);
+        std::string_view text = markdown.substr((lineBegin == std::string_view::npos) ? 0 : lineBegin + 1);
+
+        if ((maxChunkSize == 0) || (text.size() <= maxChunkSize))
+        {
+            chunks.push_back(text);
+            return chunks;
+        }
+
+        // the pieces arrive in document order and without gaps, so a chunk is
+        // the range from the first piece packed into it to the last one
+        size_t chunkBegin = 0;
+        size_t chunkEnd = 0;
+        auto pack = [&](std::string_view piece)
+        {
+            size_t pieceBegin = static_cast<size_t>(piece.data() - text.data());
+            size_t pieceEnd = pieceBegin + piece.size();
+            if ((chunkEnd > chunkBegin) && (pieceEnd - chunkBegin > maxChunkSize))
+            {
+                chunks.push_back(text.substr(chunkBegin, chunkEnd - chunkBegin));
+                chunkBegin = pieceBegin;
+            }
+            chunkEnd = pieceEnd;
+        };
+
+        ForEachSection(text,
+                       [&](std::string_view section)
+                       {
+                           if (section.size() <= maxChunkSize)
+                           {
+                               pack(section);
+                               return;
+                           }
+                           ForEachParagraph(section,
+                                            [&](std::string_view paragraph)
+                                            {
+                                                if (paragraph.size() <= maxChunkSize)
+                                                {
+                                                    pack(paragraph);
+                                                    return;
+                                                }
+                                                ForEachPiece(paragraph, maxChunkSize, pack);
+                                            });
+                       });
+
+        if (chunkEnd > chunkBegin)
+        {
+            chunks.push_back(text.substr(chunkBegin, chunkEnd - chunkBegin));
+        }
+        return chunks;
+    }
+
+    bool MarkdownChunker::IsMarkdown(fs::path const& path)
+    {
+        std::string extension = path.extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(),
+                       [](unsigned char character) { return std::tolower(character); });
+        return (extension == ".md") || (extension == ".markdown");
+    }
+
+    fs::path MarkdownChunker::GetChunkFolder(fs::path const& documentPath)
+    {
+        return documentPath.parent_path() / (documentPath.filename().string() + std::string(CHUNK_FOLDER_SUFFIX));
+    }
+
+    std::string MarkdownChunker::GetChunkFilename(size_t chunkIndex, bool output)
+    {
+        std::string number = std::to_string(chunkIndex + 1);
+        if (number.size() < 3)
+        {
+            number.insert(0, 3 - number.size(), '0');
+        }
+        return "chunk_" + number + (output ? ".output.md" : ".md");
+    }
+
+    bool MarkdownChunker::IsInChunkFolder(fs::path const& path)
+    {
+        std::string folderName = path.parent_path().filename().string();
+        if (!folderName.ends_with(CHUNK_FOLDER_SUFFIX))
+        {
+            return false;
+        }
+        folderName.resize(folderName.size() - CHUNK_FOLDER_SUFFIX.size());
+        return IsMarkdown(folderName);
+    }
+} // namespace AIAssistant
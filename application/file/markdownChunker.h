@@ -0,0 +1,50 @@
+/* Copyright (c) 2025 JC Technolabs
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+#pragma once
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace AIAssistant
+{
+    // Splits large Markdown documents into chunks that fit into one query each.
+    // Chunks end at ATX headings (# .. ######) where possible, sections larger than a
+    // chunk at paragraph breaks, and paragraphs larger than a chunk at UTF-8 character
+    // boundaries. Consecutive pieces are packed until the next one would not fit.
+    // The chunks are views into the document, in order, and concatenated give the
+    // document back (leading blank lines excepted), nothing is copied.
+    namespace MarkdownChunker
+    {
+        std::vector<std::string_view> Split(std::string_view markdown, size_t maxChunkSize);
+
+        bool IsMarkdown(fs::path const& path);
+
+        // audit copies of the chunks, "<document>_chunks/chunk_001.md" etc.
+        fs::path GetChunkFolder(fs::path const& documentPath);
+        std::string GetChunkFilename(size_t chunkIndex, bool output); // index from 0, file names count from 1
+        bool IsInChunkFolder(fs::path const& path);
+    } // namespace MarkdownChunker
+} // namespace AIAssistant
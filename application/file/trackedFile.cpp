@@ -21,46 +21,105 @@
 
 #include "trackedFile.h"
 #include "log/log.h"
-#include <fstream>
-#include <sstream>
-#include <iomanip>
-#include <openssl/sha.h> // if available, otherwise use std::hash fallback
+#include <cstdio>
 
 #include "engine.h"
+#include "file/fileHashIndex.h"
 
 namespace AIAssistant
 {
-    TrackedFile::TrackedFile(fs::path const& path, FileCategory fileCategory) : m_Path(path), m_FileCategory{fileCategory}
+    TrackedFile::TrackedFile(fs::path const& path, FileCategory fileCategory, FileIngestion& ingestion)
+        : m_Path(path), m_FileCategory{fileCategory}
     {
-        m_LastHash = ComputeFileHash();
+        m_FileStat = ingestion.GetFileStat();
+        m_LastHash = ingestion.GetHash();
+        if (ingestion.IsValid() && !ingestion.IsHashFromIndex() && !m_LastHash.IsEmpty())
+        {
+            FileHashIndex::Get().Update(m_Path.string(), m_FileStat, m_LastHash);
+        }
+
+        // keep what was read anyway, ignored files are never sent
+        if ((m_FileCategory != FileCategory::Ignored) && ingestion.HasContent())
+        {
+            m_Content = std::make_shared<std::string const>(ingestion.TakeContent());
+        }
         MarkModified(true);
     }
 
     void TrackedFile::MarkModified(bool modified) { m_Modified.store(modified); }
 
-    std::string TrackedFile::GetContent()
+    std::shared_ptr<std::string const> TrackedFile::GetContent()
     {
         std::lock_guard lock(m_Mutex);
-        std::ifstream file(m_Path);
-        if (!file.is_open())
+        if (m_Content)
+        {
+            return m_Content;
+        }
+
+        // not kept at ingestion (too large, hash from the index) or released
+        EngineCore::FileStat statBefore;
+        EngineCore::FilePtr file = EngineCore::OpenFileForReading(m_Path);
+        if (!EngineCore::GetFileStat(m_Path, statBefore) || !file)
         {
             LOG_APP_WARN("Failed to open file for reading: {}", m_Path.string());
-            return {};
+            return std::make_shared<std::string const>();
         }
 
-        std::stringstream buffer;
-        buffer << file.rdbuf();
-        return buffer.str();
+        // one sized read into the buffer that is kept, these are the large files
+        std::string buffer(statBefore.m_Size, '\0');
+        size_t bytesRead = std::fread(buffer.data(), 1, buffer.size(), file.get());
+        buffer.resize(bytesRead); // shorter if it was truncated meanwhile, the stat check below notices
+        auto content = std::make_shared<std::string const>(std::move(buffer));
+
+        // the file may have changed since it was ingested: what is sent decides the hash
+        EngineCore::Digest hash = EngineCore::ComputeHash(*content);
+        EngineCore::FileStat statAfter;
+        if (EngineCore::GetFileStat(m_Path, statAfter) && (statAfter == statBefore))
+        {
+            // not written while reading, the stat belongs to this hash
+            if ((statBefore != m_FileStat) || (hash != m_LastHash))
+            {
+                m_FileStat = statBefore;
+                FileHashIndex::Get().Update(m_Path.string(), m_FileStat, hash);
+            }
+        }
+        // else: keep the old stat, the pending modified event rechecks the file
+        m_LastHash = hash;
+        m_Content = content;
+        return content;
+    }
+
+    void TrackedFile::ReleaseContent()
+    {
+        std::lock_guard lock(m_Mutex);
+        m_Content.reset();
     }
 
-    bool TrackedFile::CheckIfContentChanged()
+    bool TrackedFile::CheckIfContentChanged(FileIngestion& ingestion)
     {
         std::lock_guard lock(m_Mutex);
 
-        std::string newHash = ComputeFileHash();
+        // same size, mtime and inode: same content, no need to read or hash
+        if (!ingestion.IsValid() || (ingestion.GetFileStat() == m_FileStat))
+        {
+            return false;
+        }
+
+        EngineCore::Digest const& newHash = ingestion.GetHash();
+        if (newHash.IsEmpty())
+        {
+            return false; // could not be read
+        }
+        m_FileStat = ingestion.GetFileStat();
+        if (!ingestion.IsHashFromIndex())
+        {
+            FileHashIndex::Get().Update(m_Path.string(), m_FileStat, newHash);
+        }
+
         if (newHash != m_LastHash)
         {
             m_LastHash = newHash;
+            m_Content = ingestion.HasContent() ? std::make_shared<std::string const>(ingestion.TakeContent()) : nullptr;
             return true;
         }
         return false;
@@ -68,32 +127,15 @@ namespace AIAssistant
 
     FileCategory TrackedFile::GetCategory() const { return m_FileCategory; }
 
-    std::string TrackedFile::ComputeFileHash() const
+    EngineCore::Digest TrackedFile::GetHash() const
     {
-        std::ifstream file(m_Path, std::ios::binary);
-        if (!file.is_open())
-        {
-            return {};
-        }
-
-        std::ostringstream oss;
-        oss << file.rdbuf();
-        std::string data = oss.str();
-
-#if __has_include(<openssl/sha.h>)
-        unsigned char hash[SHA256_DIGEST_LENGTH];
-        SHA256(reinterpret_cast<const unsigned char*>(data.data()), data.size(), hash);
-
-        std::ostringstream hex;
-        for (unsigned char c : hash)
-        {
-            hex << std::hex << std::setw(2) << std::setfill('0') << (int)c;
-        }
+        std::lock_guard lock(m_Mutex);
+        return m_LastHash;
+    }
 
-        return hex.str();
-#else
-        // fallback: lightweight std::hash
-        return std::to_string(std::hash<std::string>{}(data));
-#endif
+    EngineCore::FileStat TrackedFile::GetFileStat() const
+    {
+        std::lock_guard lock(m_Mutex);
+        return m_FileStat;
     }
 } // namespace AIAssistant
@@ -28,8 +28,12 @@
 #include <fstream>
 #include <sstream>
 #include <optional>
+#include <memory>
 
 #include "file/fileCategory.h"
+#include "file/fileIngestion.h"
+#include "auxiliary/file.h"
+#include "auxiliary/hash.h"
 
 namespace fs = std::filesystem;
 
@@ -38,7 +42,7 @@ namespace AIAssistant
     class TrackedFile
     {
     public:
-        TrackedFile(fs::path const& path, FileCategory fileCategory);
+        TrackedFile(fs::path const& path, FileCategory fileCategory, FileIngestion& ingestion);
 
         bool IsModified() const { return m_Modified.load(); }
         fs::path const& GetPath() const { return m_Path; }
@@ -46,22 +50,27 @@ namespace AIAssistant
         // marks it as modified
         void MarkModified(bool modified = true);
 
-        // retrieves content (and resets modified flag)
-        std::string GetContent();
+        // retrieves content, cached until the file is modified or released; the buffer stays valid
+        // for the holder either way. Reading it from disk rehashes it, so GetHash() afterwards belongs
+        // to exactly the returned bytes.
+        std::shared_ptr<std::string const> GetContent();
+        // drops the cached content, e.g. after it was sent
+        void ReleaseContent();
         FileCategory GetCategory() const;
+        EngineCore::Digest GetHash() const;
+        EngineCore::FileStat GetFileStat() const; // of the version GetHash() belongs to
 
         // called when file changes on disk
         // to make sure it really changed
-        bool CheckIfContentChanged();
-
-    private:
-        std::string ComputeFileHash() const;
+        bool CheckIfContentChanged(FileIngestion& ingestion);
 
     private:
         fs::path m_Path;
         FileCategory m_FileCategory;
         std::atomic<bool> m_Modified{true}; // all new files start "modified"
-        std::string m_LastHash;
+        EngineCore::Digest m_LastHash;
+        EngineCore::FileStat m_FileStat; // stat of the hashed version
+        std::shared_ptr<std::string const> m_Content; // null: not cached
         mutable std::mutex m_Mutex;
     };
 } // namespace AIAssistant
@@ -27,6 +27,10 @@
 #include "log/terminalManager.h"
 #include "file/fileWatcher.h"
 #include "file/probUtils.h"
+#include "file/fileHashIndex.h"
+#include "session/responseCache.h"
+#include "session/usageMetrics.h"
+#include "session/queryCompletedEvent.h"
 #include "web/chatMessages.h"
 #include "python/pythonEngine.h"
 
@@ -65,7 +69,7 @@ namespace AIAssistant
                             sessionCount = 1;
                         }
 
-                        int statusHeight = static_cast<int>(sessionCount);
+                        int statusHeight = static_cast<int>(sessionCount) + 1; // + usage totals
 
                         // ensure at least 1 line, and leave at least 1 for log
                         if (statusHeight >= totalRows)
@@ -83,6 +87,17 @@ namespace AIAssistant
         // ---------------------------------------------------------
         const auto& queuePath = Core::g_Core->GetConfig().m_QueueFolderFilepath;
 
+        // must be loaded before the file watcher reports the existing files
+        FileHashIndex::Get().Load(GetStateFolder() / "fileIndex.bin");
+        m_LastIndexSaveTime = std::chrono::steady_clock::now();
+
+        {
+            auto const& config = Core::g_Core->GetConfig();
+            ResponseCache::Get().Load(GetStateFolder() / "responseCache", config.m_ResponseCacheSizeMB * 1024 * 1024,
+                                      config.m_ResponseCacheTimeToLive);
+            UsageMetrics::Get().Load(GetStateFolder() / "usage.jsonl", config.m_UsageLogSizeMB * 1024 * 1024);
+        }
+
         m_FileWatcher = std::make_unique<FileWatcher>(queuePath, 100ms);
         m_FileWatcher->Start();
 
@@ -140,6 +155,12 @@ namespace AIAssistant
             }
         }
 
+        // persist hashes periodically, so a crash doesn't lose them
+        if ((std::chrono::steady_clock::now() - m_LastIndexSaveTime) >= 10s)
+        {
+            SaveFileHashIndex();
+        }
+
         // Termination logic
         CheckIfFinished();
     }
@@ -151,6 +172,21 @@ namespace AIAssistant
         auto& event = *eventPtr.get();
         EventDispatcher dispatcher(event);
 
+        // replies go back to the session that sent the query
+        if (dispatcher.Dispatch<QueryCompletedEvent>(
+                [&](QueryCompletedEvent& queryEvent)
+                {
+                    auto iterator = m_SessionManagers.find(queryEvent.GetSessionName());
+                    if (iterator != m_SessionManagers.end())
+                    {
+                        iterator->second->OnEvent(queryEvent);
+                    }
+                    return true;
+                }))
+        {
+            return;
+        }
+
         // ---------------------------------------------------------
         // App-level event handling
         // ---------------------------------------------------------
@@ -189,6 +225,7 @@ namespace AIAssistant
             [&](FileRemovedEvent& fileEvent)
             {
                 filePath = fileEvent.GetPath();
+                FileHashIndex::Get().Remove(fileEvent.GetPath());
                 return false;
             });
 
@@ -266,6 +303,10 @@ namespace AIAssistant
     void JarvisAgent::OnShutdown()
     {
         LOG_APP_INFO("leaving JarvisAgent");
+
+        // streamed chat deltas reach the chat message pool and the web server from the curl event loop:
+        // end all transfers before either goes away (Core::Shutdown() finds the engine stopped)
+        Core::g_Core->GetCurlMulti().Stop();
         App::g_App = nullptr;
 
         for (auto& sessionManager : m_SessionManagers)
@@ -281,6 +322,7 @@ namespace AIAssistant
 
         {
             m_FileWatcher->Stop();
+            FileHashIndex::Get().Save(true /*pruneMissingFiles*/);
         }
 
         {
@@ -292,6 +334,24 @@ namespace AIAssistant
 
     bool JarvisAgent::IsFinished() const { return m_IsFinished; }
 
+    bool JarvisAgent::IsBusy() const
+    {
+        // outstanding work keeps the run loop (and the status spinner) going; a session that waits
+        // for a missing STNG/CNTX/TASK file has nothing to do, events wake the loop when it arrives
+        if (Core::g_Core->GetCurlMulti().GetInFlight() != 0)
+        {
+            return true;
+        }
+        for (auto const& sessionManager : m_SessionManagers)
+        {
+            if (sessionManager.second->HasOutstandingWork())
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
     void JarvisAgent::CheckIfFinished()
     {
         // Ctrl+C is caught by engine and breaks run loop
@@ -302,4 +362,19 @@ namespace AIAssistant
         return std::chrono::duration_cast<std::chrono::nanoseconds>(m_StartupTime.time_since_epoch()).count();
     }
 
+    fs::path JarvisAgent::GetStateFolder() const
+    {
+        return fs::path(Core::g_Core->GetConfig().m_QueueFolderFilepath) / ".jarvis";
+    }
+
+    void JarvisAgent::SaveFileHashIndex()
+    {
+        m_LastIndexSaveTime = std::chrono::steady_clock::now();
+        auto& fileHashIndex = FileHashIndex::Get();
+        if (fileHashIndex.IsDirty())
+        {
+            fileHashIndex.Save();
+        }
+    }
+
 } // namespace AIAssistant
@@ -23,11 +23,14 @@
 #include <chrono>
 #include <memory>
 #include <unordered_map>
+#include <filesystem>
 
 #include "application.h"
 #include "file/fileCategory.h"
 #include "log/statusRenderer.h"
 
+namespace fs = std::filesystem;
+
 namespace AIAssistant
 {
     class SessionManager;
@@ -48,17 +51,20 @@ namespace AIAssistant
         virtual void OnShutdown() override;
 
         virtual bool IsFinished() const override;
+        virtual bool IsBusy() const override;
         static std::unique_ptr<Application> Create();
 
         WebServer* GetWebServer() const { return m_WebServer.get(); }
         ChatMessagePool* GetChatMessagePool() const { return m_ChatMessagePool.get(); }
         std::chrono::system_clock::time_point GetStartupTime() const { return m_StartupTime; }
         int64_t GetStartupTimestamp() const;
+        fs::path GetStateFolder() const; // hidden folder in the queue for persistent state
         StatusRenderer& GetStatusRenderer() { return m_StatusRenderer; }
         PythonEngine* GetPythonEngine() { return m_PythonEngine.get(); }
 
     private:
         void CheckIfFinished();
+        void SaveFileHashIndex();
 
     private:
         bool m_IsFinished{false};
@@ -66,6 +72,7 @@ namespace AIAssistant
     private:
         StatusRenderer m_StatusRenderer;
         std::chrono::system_clock::time_point m_StartupTime;
+        std::chrono::steady_clock::time_point m_LastIndexSaveTime;
 
         // submodules
         std::unordered_map<std::string, std::unique_ptr<SessionManager>> m_SessionManagers;
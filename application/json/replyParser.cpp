@@ -23,16 +23,41 @@
 #include "json/replyParser.h"
 #include "json/replyParserAPI1.h"
 #include "json/replyParserAPI2.h"
+#include "json/jsonHelper.h"
 
 namespace AIAssistant
 {
 
-    ReplyParser::ReplyParser(std::string const& jsonString) : m_JsonString(jsonString) {}
+    ReplyParser::ReplyParser(std::string&& jsonString) : m_JsonString(std::move(jsonString)) {}
 
     bool ReplyParser::HasError() const { return m_HasError; }
 
+    simdjson::ondemand::parser& ReplyParser::GetThreadParser()
+    {
+        thread_local simdjson::ondemand::parser parser;
+        return parser;
+    }
+
+    simdjson::error_code ReplyParser::Iterate(simdjson::ondemand::document& document)
+    {
+        // the curl multi engine already keeps SIMDJSON_PADDING spare bytes, then this is a no-op
+        if (m_JsonString.capacity() - m_JsonString.size() < simdjson::SIMDJSON_PADDING)
+        {
+            m_JsonString.reserve(m_JsonString.size() + simdjson::SIMDJSON_PADDING);
+        }
+        simdjson::padded_string_view json(m_JsonString.data(), m_JsonString.size(), m_JsonString.capacity());
+        return GetThreadParser().iterate(json).get(document);
+    }
+
+    std::string_view ReplyParser::GetString(simdjson::ondemand::value value)
+    {
+        // the raw string points into m_JsonString, which simdjson iterates without copying
+        simdjson::ondemand::raw_json_string rawString = value.get_raw_json_string();
+        return JsonHelper().UnescapeInPlace(const_cast<char*>(rawString.raw()));
+    }
+
     std::unique_ptr<ReplyParser> ReplyParser::Create(ConfigParser::EngineConfig::InterfaceType const& interfaceType,
-                                                     std::string const& jsonString)
+                                                     std::string&& jsonString)
     {
         std::unique_ptr<ReplyParser> replyParser;
 
@@ -40,12 +65,12 @@ namespace AIAssistant
         {
             case ConfigParser::EngineConfig::InterfaceType::API1:
             {
-                replyParser = std::make_unique<ReplyParserAPI1>(jsonString);
+                replyParser = std::make_unique<ReplyParserAPI1>(std::move(jsonString));
                 break;
             }
             case ConfigParser::EngineConfig::InterfaceType::API2:
             {
-                replyParser = std::make_unique<ReplyParserAPI2>(jsonString);
+                replyParser = std::make_unique<ReplyParserAPI2>(std::move(jsonString));
                 break;
             }
             default:
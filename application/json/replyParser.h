@@ -21,8 +21,10 @@
 
 #pragma once
 #include <string>
+#include <string_view>
 #include <memory>
 #include "json/configParser.h"
+#include "simdjson/simdjson.h"
 
 namespace AIAssistant
 {
@@ -39,16 +41,39 @@ namespace AIAssistant
             ReplyError
         };
 
+        // token counts as reported by the API, zero if the reply had none
+        struct Usage
+        {
+            uint64_t m_InputTokens{0};
+            uint64_t m_CachedTokens{0}; // part of m_InputTokens served from the prompt cache
+            uint64_t m_OutputTokens{0};
+            uint64_t m_TotalTokens{0};
+        };
+
     public:
-        ReplyParser(std::string const& jsonString);
+        // takes over the receive buffer, the reply's strings are views into it
+        ReplyParser(std::string&& jsonString);
         virtual ~ReplyParser() = default;
 
+        ReplyParser(ReplyParser const&) = delete;
+        ReplyParser& operator=(ReplyParser const&) = delete;
+
         bool HasError() const;
         virtual size_t HasContent() const = 0;
-        virtual std::string GetContent(size_t index = 0) const = 0;
+        virtual std::string_view GetContent(size_t index = 0) const = 0;
+        virtual Usage GetUsage() const = 0;
+        virtual std::string_view GetErrorMessage() const = 0;
 
         static std::unique_ptr<ReplyParser> Create(ConfigParser::EngineConfig::InterfaceType const& interfaceType,
-                                                   std::string const& jsonString);
+                                                   std::string&& jsonString);
+
+    protected:
+        // one parser per thread, it keeps its capacity from reply to reply
+        static simdjson::ondemand::parser& GetThreadParser();
+        // starts iterating m_JsonString in place, pads the buffer only if the receiver did not
+        simdjson::error_code Iterate(simdjson::ondemand::document& document);
+        // decodes a string value in place and returns a view into m_JsonString
+        static std::string_view GetString(simdjson::ondemand::value value);
 
     protected:
         ReplyParser::State m_State;
@@ -26,7 +26,7 @@
 
 namespace AIAssistant
 {
-    ReplyParserAPI1::ReplyParserAPI1(std::string const& jsonString) : ReplyParser(jsonString) { Parse(); }
+    ReplyParserAPI1::ReplyParserAPI1(std::string&& jsonString) : ReplyParser(std::move(jsonString)) { Parse(); }
 
     ReplyParserAPI1::ErrorInfo const& ReplyParserAPI1::GetErrorInfo() const { return m_ErrorInfo; }
 
@@ -34,7 +34,17 @@ namespace AIAssistant
 
     size_t ReplyParserAPI1::HasContent() const { return m_Reply.m_Choices.size(); }
 
-    std::string ReplyParserAPI1::GetContent(size_t index) const
+    ReplyParser::Usage ReplyParserAPI1::GetUsage() const
+    {
+        return Usage{
+            .m_InputTokens = m_Reply.m_Usage.m_PromptTokens,      //
+            .m_CachedTokens = m_Reply.m_Usage.m_CachedTokens,     //
+            .m_OutputTokens = m_Reply.m_Usage.m_CompletionTokens, //
+            .m_TotalTokens = m_Reply.m_Usage.m_TotalTokens        //
+        };
+    }
+
+    std::string_view ReplyParserAPI1::GetContent(size_t index) const
     {
         if (index < m_Reply.m_Choices.size())
         {
@@ -47,12 +57,10 @@ namespace AIAssistant
     void ReplyParserAPI1::Parse()
     {
         using namespace simdjson;
-        ondemand::parser parser;
-
-        padded_string json = padded_string(m_JsonString.data(), m_JsonString.size());
 
+        // single pass over the receive buffer
         ondemand::document doc;
-        auto error = parser.iterate(json).get(doc);
+        auto error = Iterate(doc);
 
         if (error)
         {
@@ -61,8 +69,7 @@ namespace AIAssistant
             return;
         }
 
-        ondemand::document sceneDocument = parser.iterate(json);
-        ondemand::object jsonObjects = sceneDocument.get_object();
+        ondemand::object jsonObjects = doc.get_object();
 
         Reply reply{};
 
@@ -73,30 +80,30 @@ namespace AIAssistant
             if (key == "id")
             {
                 CORE_ASSERT((jsonObject.value().type() == ondemand::json_type::string), "id must be string");
-                std::string_view id = jsonObject.value().get_string();
+                std::string_view id = GetString(jsonObject.value());
                 LOG_APP_INFO("id: {}", id);
-                m_Reply.m_Id = id;
+                reply.m_Id = id;
             }
             else if (key == "object")
             {
                 CORE_ASSERT((jsonObject.value().type() == ondemand::json_type::string), "object must be string");
-                std::string_view object = jsonObject.value().get_string();
+                std::string_view object = GetString(jsonObject.value());
                 LOG_APP_INFO("object: {}", object);
-                m_Reply.m_Object = object;
+                reply.m_Object = object;
             }
             else if (key == "created")
             {
                 CORE_ASSERT((jsonObject.value().type() == ondemand::json_type::number), "created must be integer");
                 uint64_t created = jsonObject.value().get_uint64();
                 LOG_APP_INFO("created: {}", created);
-                m_Reply.m_Created = created;
+                reply.m_Created = created;
             }
             else if (key == "model")
             {
                 CORE_ASSERT((jsonObject.value().type() == ondemand::json_type::string), "model must be string");
-                std::string_view model = jsonObject.value().get_string();
+                std::string_view model = GetString(jsonObject.value());
                 LOG_APP_INFO("model: {}", model);
-                m_Reply.m_Model = model;
+                reply.m_Model = model;
             }
             else if (key == "choices")
             {
@@ -108,7 +115,7 @@ namespace AIAssistant
             else if (key == "usage")
             {
                 CORE_ASSERT((jsonObject.value().type() == ondemand::json_type::object), "type must be object");
-                ParseUsage(jsonObject.value());
+                ParseUsage(jsonObject.value(), reply);
             }
             else if (key == "error")
             {
@@ -194,7 +201,7 @@ namespace AIAssistant
                         if (msgKey == "role")
                         {
                             CORE_ASSERT((messageField.value().type() == ondemand::json_type::string), "role must be string");
-                            std::string_view role = messageField.value().get_string();
+                            std::string_view role = GetString(messageField.value());
                             LOG_APP_INFO("role: {}", role);
                             choice.m_Message.m_Role = role;
                         }
@@ -202,7 +209,7 @@ namespace AIAssistant
                         {
                             CORE_ASSERT((messageField.value().type() == ondemand::json_type::string),
                                         "content must be string");
-                            std::string_view content = messageField.value().get_string();
+                            std::string_view content = GetString(messageField.value());
                             LOG_APP_INFO("content:");
                             std::cout << content << "\n";
                             choice.m_Message.m_Content = content;
@@ -217,7 +224,7 @@ namespace AIAssistant
                 else if (key == "finish_reason")
                 {
                     CORE_ASSERT((field.value().type() == ondemand::json_type::string), "finish_reason must be string");
-                    std::string_view reason = field.value().get_string();
+                    std::string_view reason = GetString(field.value());
                     LOG_APP_INFO("finish_reason: {}", reason);
                     choice.m_FinishReason = reason;
                 }
@@ -232,7 +239,7 @@ namespace AIAssistant
         }
     }
 
-    void ReplyParserAPI1::ParseUsage(simdjson::ondemand::object jsonObjects)
+    void ReplyParserAPI1::ParseUsage(simdjson::ondemand::object jsonObjects, Reply& reply)
     {
         using namespace simdjson;
 
@@ -244,21 +251,31 @@ namespace AIAssistant
                 CORE_ASSERT((jsonObject.value().type() == ondemand::json_type::number), "type must be a number");
                 uint64_t tokens = jsonObject.value().get_uint64();
                 LOG_APP_INFO("prompt_tokens: {}", tokens);
-                m_Reply.m_Usage.m_PromptTokens = tokens;
+                reply.m_Usage.m_PromptTokens = tokens;
+            }
+            else if (key == "prompt_tokens_details")
+            {
+                CORE_ASSERT((jsonObject.value().type() == ondemand::json_type::object), "type must be an object");
+                uint64_t tokens{0};
+                if (!jsonObject.value()["cached_tokens"].get(tokens))
+                {
+                    LOG_APP_INFO("cached_tokens: {}", tokens);
+                    reply.m_Usage.m_CachedTokens = tokens;
+                }
             }
             else if (key == "completion_tokens")
             {
                 CORE_ASSERT((jsonObject.value().type() == ondemand::json_type::number), "type must be a number");
                 uint64_t tokens = jsonObject.value().get_uint64();
                 LOG_APP_INFO("completion_tokens: {}", tokens);
-                m_Reply.m_Usage.m_CompletionTokens = tokens;
+                reply.m_Usage.m_CompletionTokens = tokens;
             }
             else if (key == "total_tokens")
             {
                 CORE_ASSERT((jsonObject.value().type() == ondemand::json_type::number), "type must be a number");
                 uint64_t tokens = jsonObject.value().get_uint64();
                 LOG_APP_INFO("total_tokens: {}", tokens);
-                m_Reply.m_Usage.m_TotalTokens = tokens;
+                reply.m_Usage.m_TotalTokens = tokens;
             }
             else
             {
@@ -279,7 +296,7 @@ namespace AIAssistant
             if (key == "message")
             {
                 CORE_ASSERT((jsonObject.value().type() == ondemand::json_type::string), "type must be string");
-                std::string_view message = jsonObject.value().get_string();
+                std::string_view message = GetString(jsonObject.value());
                 LOG_APP_INFO("message:");
                 std::cout << message << "\n";
                 errorInfo.m_Message = message;
@@ -287,23 +304,26 @@ namespace AIAssistant
             else if (key == "type")
             {
                 CORE_ASSERT((jsonObject.value().type() == ondemand::json_type::string), "type must be string");
-                std::string_view type = jsonObject.value().get_string();
+                std::string_view type = GetString(jsonObject.value());
                 LOG_APP_INFO("type: {}", type);
                 errorInfo.m_Type = type;
             }
             else if (key == "code")
             {
-                CORE_ASSERT((jsonObject.value().type() == ondemand::json_type::string), "type must be string");
-                std::string_view code = jsonObject.value().get_string();
-                LOG_APP_INFO("code: {}", code);
-                errorInfo.m_Code = code;
+                if (!jsonObject.value().is_null())
+                {
+                    CORE_ASSERT((jsonObject.value().type() == ondemand::json_type::string), "type must be string");
+                    std::string_view code = GetString(jsonObject.value());
+                    LOG_APP_INFO("code: {}", code);
+                    errorInfo.m_Code = code;
+                }
             }
             else if (key == "param")
             {
                 if (!jsonObject.value().is_null())
                 {
                     CORE_ASSERT((jsonObject.value().type() == ondemand::json_type::string), "type must be string");
-                    std::string_view param = jsonObject.value().get_string();
+                    std::string_view param = GetString(jsonObject.value());
                     LOG_APP_INFO("parameter: {}", param);
                     errorInfo.m_Param = param;
                 }
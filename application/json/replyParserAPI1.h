@@ -49,32 +49,35 @@ namespace AIAssistant
         //  ],
         //  "usage": {
         //    "prompt_tokens": 55,
+        //    "prompt_tokens_details": { "cached_tokens": 0 },
         //    "completion_tokens": 17,
         //    "total_tokens": 72
         //  }
+        // strings are views into the receive buffer owned by the parser
         struct Reply
         {
             struct Choice
             {
                 struct Message
                 {
-                    std::string m_Role;
-                    std::string m_Content;
+                    std::string_view m_Role;
+                    std::string_view m_Content;
                 };
                 uint64_t m_Index{0};
                 Message m_Message;
-                std::string m_FinishReason;
+                std::string_view m_FinishReason;
             };
             struct Usage
             {
                 uint64_t m_PromptTokens{0};
+                uint64_t m_CachedTokens{0};
                 uint64_t m_CompletionTokens{0};
                 uint64_t m_TotalTokens{0};
             };
-            std::string m_Id;
-            std::string m_Object;
-            int m_Created;
-            std::string m_Model;
+            std::string_view m_Id;
+            std::string_view m_Object;
+            uint64_t m_Created{0};
+            std::string_view m_Model;
             std::vector<Choice> m_Choices;
             Usage m_Usage;
         };
@@ -82,10 +85,10 @@ namespace AIAssistant
         // error handling
         struct ErrorInfo
         {
-            std::string m_Message;
-            std::string m_Type;
-            std::string m_Code;
-            std::string m_Param;
+            std::string_view m_Message;
+            std::string_view m_Type;
+            std::string_view m_Code;
+            std::string_view m_Param;
         };
 
         enum class ErrorType
@@ -100,19 +103,21 @@ namespace AIAssistant
         };
 
     public:
-        ReplyParserAPI1(std::string const& jsonString);
+        explicit ReplyParserAPI1(std::string&& jsonString);
         virtual ~ReplyParserAPI1() = default;
 
         ErrorInfo const& GetErrorInfo() const;
         ErrorType GetErrorType() const;
 
         virtual size_t HasContent() const override;
-        virtual std::string GetContent(size_t index = 0) const override;
+        virtual std::string_view GetContent(size_t index = 0) const override;
+        virtual Usage GetUsage() const override;
+        virtual std::string_view GetErrorMessage() const override { return m_ErrorInfo.m_Message; }
 
     private:
         void Parse();
         void ParseContent(simdjson::ondemand::array, Reply&);
-        void ParseUsage(simdjson::ondemand::object);
+        void ParseUsage(simdjson::ondemand::object, Reply&);
         void ParseError(simdjson::ondemand::object);
         ReplyParserAPI1::ErrorType ParseErrorType(std::string_view type);
 
@@ -26,7 +26,7 @@
 
 namespace AIAssistant
 {
-    ReplyParserAPI2::ReplyParserAPI2(std::string const& jsonString) : ReplyParser(jsonString) { Parse(); }
+    ReplyParserAPI2::ReplyParserAPI2(std::string&& jsonString) : ReplyParser(std::move(jsonString)) { Parse(); }
 
     ReplyParserAPI2::ErrorInfo const& ReplyParserAPI2::GetErrorInfo() const { return m_ErrorInfo; }
 
@@ -38,7 +38,17 @@ namespace AIAssistant
         return returnValue;
     }
 
-    std::string ReplyParserAPI2::GetContent(size_t index) const
+    ReplyParser::Usage ReplyParserAPI2::GetUsage() const
+    {
+        return Usage{
+            .m_InputTokens = m_Reply.m_Usage.m_InputTokens,   //
+            .m_CachedTokens = m_Reply.m_Usage.m_CachedTokens, //
+            .m_OutputTokens = m_Reply.m_Usage.m_OutputTokens, //
+            .m_TotalTokens = m_Reply.m_Usage.m_TotalTokens    //
+        };
+    }
+
+    std::string_view ReplyParserAPI2::GetContent(size_t index) const
     {
         if (index < m_Reply.m_Output.size())
         {
@@ -56,12 +66,10 @@ namespace AIAssistant
     void ReplyParserAPI2::Parse()
     {
         using namespace simdjson;
-        ondemand::parser parser;
-
-        padded_string json = padded_string(m_JsonString.data(), m_JsonString.size());
 
+        // single pass over the receive buffer
         ondemand::document doc;
-        auto error = parser.iterate(json).get(doc);
+        auto error = Iterate(doc);
 
         if (error)
         {
@@ -70,8 +78,7 @@ namespace AIAssistant
             return;
         }
 
-        ondemand::document responseDocument = parser.iterate(json);
-        ondemand::object jsonObjects = responseDocument.get_object();
+        ondemand::object jsonObjects = doc.get_object();
 
         Reply reply{};
 
@@ -81,13 +88,13 @@ namespace AIAssistant
 
             if (key == "id")
             {
-                std::string_view id = jsonObject.value().get_string();
+                std::string_view id = GetString(jsonObject.value());
                 LOG_APP_INFO("id: {}", id);
                 reply.m_Id = id;
             }
             else if (key == "object")
             {
-                std::string_view object = jsonObject.value().get_string();
+                std::string_view object = GetString(jsonObject.value());
                 LOG_APP_INFO("object: {}", object);
                 reply.m_Object = object;
             }
@@ -99,13 +106,13 @@ namespace AIAssistant
             }
             else if (key == "status")
             {
-                std::string_view status = jsonObject.value().get_string();
+                std::string_view status = GetString(jsonObject.value());
                 LOG_APP_INFO("status: {}", status);
                 reply.m_Status = status;
             }
             else if (key == "model")
             {
-                std::string_view model = jsonObject.value().get_string();
+                std::string_view model = GetString(jsonObject.value());
                 LOG_APP_INFO("model: {}", model);
                 reply.m_Model = model;
             }
@@ -117,7 +124,7 @@ namespace AIAssistant
             }
             else if (key == "usage")
             {
-                ParseUsage(jsonObject.value());
+                ParseUsage(jsonObject.value(), reply);
             }
             else if (key == "error")
             {
@@ -161,23 +168,19 @@ namespace AIAssistant
 
                 if (key == "id")
                 {
-                    std::string_view id = field.value().get_string();
-                    output.m_Id = std::string(id);
+                    output.m_Id = GetString(field.value());
                 }
                 else if (key == "type")
                 {
-                    std::string_view type = field.value().get_string();
-                    output.m_Type = std::string(type);
+                    output.m_Type = GetString(field.value());
                 }
                 else if (key == "status")
                 {
-                    std::string_view status = field.value().get_string();
-                    output.m_Status = std::string(status);
+                    output.m_Status = GetString(field.value());
                 }
                 else if (key == "role")
                 {
-                    std::string_view role = field.value().get_string();
-                    output.m_Role = std::string(role);
+                    output.m_Role = GetString(field.value());
                 }
                 else if (key == "content")
                 {
@@ -192,13 +195,11 @@ namespace AIAssistant
                             std::string_view ck = contentField.unescaped_key();
                             if (ck == "type")
                             {
-                                std::string_view type = contentField.value().get_string();
-                                content.m_Type = std::string(type);
+                                content.m_Type = GetString(contentField.value());
                             }
                             else if (ck == "text")
                             {
-                                std::string_view text = contentField.value().get_string();
-                                content.m_Text = std::string(text);
+                                content.m_Text = GetString(contentField.value());
                             }
                         }
                         if (!content.m_Text.empty())
@@ -229,7 +230,7 @@ namespace AIAssistant
         }
     }
 
-    void ReplyParserAPI2::ParseUsage(simdjson::ondemand::object usageObj)
+    void ReplyParserAPI2::ParseUsage(simdjson::ondemand::object usageObj, Reply& reply)
     {
         using namespace simdjson;
 
@@ -238,18 +239,27 @@ namespace AIAssistant
             std::string_view key = field.unescaped_key();
             if (key == "input_tokens")
             {
-                m_Reply.m_Usage.m_InputTokens = field.value().get_uint64();
-                LOG_APP_INFO("input_tokens: {}", m_Reply.m_Usage.m_InputTokens);
+                reply.m_Usage.m_InputTokens = field.value().get_uint64();
+                LOG_APP_INFO("input_tokens: {}", reply.m_Usage.m_InputTokens);
+            }
+            else if (key == "input_tokens_details")
+            {
+                uint64_t tokens{0};
+                if (!field.value()["cached_tokens"].get(tokens))
+                {
+                    reply.m_Usage.m_CachedTokens = tokens;
+                    LOG_APP_INFO("cached_tokens: {}", tokens);
+                }
             }
             else if (key == "output_tokens")
             {
-                m_Reply.m_Usage.m_OutputTokens = field.value().get_uint64();
-                LOG_APP_INFO("output_tokens: {}", m_Reply.m_Usage.m_OutputTokens);
+                reply.m_Usage.m_OutputTokens = field.value().get_uint64();
+                LOG_APP_INFO("output_tokens: {}", reply.m_Usage.m_OutputTokens);
             }
             else if (key == "total_tokens")
             {
-                m_Reply.m_Usage.m_TotalTokens = field.value().get_uint64();
-                LOG_APP_INFO("total_tokens: {}", m_Reply.m_Usage.m_TotalTokens);
+                reply.m_Usage.m_TotalTokens = field.value().get_uint64();
+                LOG_APP_INFO("total_tokens: {}", reply.m_Usage.m_TotalTokens);
             }
             else
             {
@@ -270,25 +280,24 @@ namespace AIAssistant
             std::string_view key = field.unescaped_key();
             if (key == "message")
             {
-                std::string_view message = field.value().get_string();
-                errorInfo.m_Message = std::string(message);
+                errorInfo.m_Message = GetString(field.value());
             }
             else if (key == "type")
             {
-                std::string_view type = field.value().get_string();
-                errorInfo.m_Type = std::string(type);
+                errorInfo.m_Type = GetString(field.value());
             }
             else if (key == "code")
             {
-                std::string_view code = field.value().get_string();
-                errorInfo.m_Code = std::string(code);
+                if (!field.value().is_null())
+                {
+                    errorInfo.m_Code = GetString(field.value());
+                }
             }
             else if (key == "param")
             {
                 if (!field.value().is_null())
                 {
-                    std::string_view param = field.value().get_string();
-                    errorInfo.m_Param = std::string(param);
+                    errorInfo.m_Param = GetString(field.value());
                 }
             }
             else
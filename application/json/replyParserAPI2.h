@@ -61,41 +61,44 @@ namespace AIAssistant
         //   ],
         //   "usage": {
         //     "input_tokens": 14,
+        //     "input_tokens_details": { "cached_tokens": 0 },
         //     "output_tokens": 726,
         //     "total_tokens": 740
         //   }
         // }
         // ------------------------------------------------------------------
 
+        // strings are views into the receive buffer owned by the parser
         struct Reply
         {
             struct Output
             {
                 struct Content
                 {
-                    std::string m_Type; // usually "output_text"
-                    std::string m_Text; // assistant text output
+                    std::string_view m_Type; // usually "output_text"
+                    std::string_view m_Text; // assistant text output
                 };
 
-                std::string m_Id;     // message or reasoning id
-                std::string m_Type;   // "message" or "reasoning"
-                std::string m_Status; // may be "completed"
-                std::string m_Role;   // "assistant" or "user"
+                std::string_view m_Id;     // message or reasoning id
+                std::string_view m_Type;   // "message" or "reasoning"
+                std::string_view m_Status; // may be "completed"
+                std::string_view m_Role;   // "assistant" or "user"
                 std::vector<Content> m_Content;
             };
 
             struct Usage
             {
                 uint64_t m_InputTokens{0};
+                uint64_t m_CachedTokens{0};
                 uint64_t m_OutputTokens{0};
                 uint64_t m_TotalTokens{0};
             };
 
-            std::string m_Id;
-            std::string m_Object;
+            std::string_view m_Id;
+            std::string_view m_Object;
             uint64_t m_CreatedAt{0};
-            std::string m_Status;
-            std::string m_Model;
+            std::string_view m_Status;
+            std::string_view m_Model;
             std::vector<Output> m_Output;
             Usage m_Usage;
         };
@@ -103,10 +106,10 @@ namespace AIAssistant
         // error handling
         struct ErrorInfo
         {
-            std::string m_Message;
-            std::string m_Type;
-            std::string m_Code;
-            std::string m_Param;
+            std::string_view m_Message;
+            std::string_view m_Type;
+            std::string_view m_Code;
+            std::string_view m_Param;
         };
 
         enum class ErrorType
@@ -121,19 +124,21 @@ namespace AIAssistant
         };
 
     public:
-        explicit ReplyParserAPI2(std::string const& jsonString);
+        explicit ReplyParserAPI2(std::string&& jsonString);
         virtual ~ReplyParserAPI2() = default;
 
         ErrorInfo const& GetErrorInfo() const;
         ErrorType GetErrorType() const;
 
         virtual size_t HasContent() const override;
-        virtual std::string GetContent(size_t index = 0) const override;
+        virtual std::string_view GetContent(size_t index = 0) const override;
+        virtual Usage GetUsage() const override;
+        virtual std::string_view GetErrorMessage() const override { return m_ErrorInfo.m_Message; }
 
     private:
         void Parse();
         void ParseOutput(simdjson::ondemand::array, Reply&);
-        void ParseUsage(simdjson::ondemand::object);
+        void ParseUsage(simdjson::ondemand::object, Reply&);
         void ParseError(simdjson::ondemand::object);
         ReplyParserAPI2::ErrorType ParseErrorType(std::string_view type);
 
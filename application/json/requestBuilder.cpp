@@ -0,0 +1,76 @@
+/* Copyright (c) 2025 JC Technolabs
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+#include "json/requestBuilder.h"
+#include "json/jsonHelper.h"
+
+namespace AIAssistant
+{
+    RequestBuilder::RequestBuilder(ConfigParser::EngineConfig::InterfaceType interfaceType, std::string const& model,
+                                   bool store, bool stream)
+    {
+        // with "stream": true the reply arrives as server-sent events, see StreamingReply
+        std::string streamField = stream ? R"(, "stream": true)" : "";
+
+        // R"(...)" introduces a raw string literal, everything between the parentheses is taken literally
+        switch (interfaceType)
+        {
+            case ConfigParser::EngineConfig::InterfaceType::API1:
+            {
+                m_Prefix = std::make_shared<std::string const>(R"({"model": ")" + model +
+                                                               R"(","messages": [{"role": "system", "content": ")");
+                m_Separator = std::make_shared<std::string const>(R"("}, {"role": "user", "content": ")");
+                // API1 leaves usage out of a stream unless asked for, API2 always sends it
+                std::string usageField = stream ? R"(, "stream_options": {"include_usage": true})" : "";
+                m_Suffix = std::make_shared<std::string const>(R"("}])" + streamField + usageField + "}");
+                break;
+            }
+            case ConfigParser::EngineConfig::InterfaceType::API2:
+            {
+                m_Prefix = std::make_shared<std::string const>(R"({"model": ")" + model + R"(", "instructions": ")");
+                m_Separator = std::make_shared<std::string const>(R"(", "input": ")");
+                m_Suffix = std::make_shared<std::string const>(R"(", "store": )" + std::string(store ? "true" : "false") +
+                                                               streamField + "}");
+                break;
+            }
+            default:
+                break; // rejected by the config checker
+        };
+    }
+
+    RequestBody RequestBuilder::Build(std::vector<RequestBody::Segment> const& escapedEnvironment,
+                                      std::string_view content) const
+    {
+        std::string escapedContent;
+        JsonHelper().AppendSanitizedForJson(escapedContent, content);
+
+        RequestBody body;
+        body.Append(m_Prefix);
+        for (auto const& segment : escapedEnvironment)
+        {
+            body.Append(segment);
+        }
+        body.Append(m_Separator);
+        body.Append(std::move(escapedContent));
+        body.Append(m_Suffix);
+        return body;
+    }
+} // namespace AIAssistant
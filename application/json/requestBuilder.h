@@ -0,0 +1,54 @@
+/* Copyright (c) 2025 JC Technolabs
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "json/configParser.h"
+#include "curlWrapper/requestBody.h"
+
+namespace AIAssistant
+{
+    // Builds request bodies for one model and interface without concatenating the prompt:
+    // the JSON around the prompt is built once, the escaped environment segments are shared by
+    // all requests of an environment version, only the requirement content is escaped per request.
+    // The environment goes first and on its own (system message, instructions), so all requests
+    // of a session start with the same tokens and hit the provider's prompt prefix cache.
+    //
+    // API1: {"model": "gpt-4.1","messages": [{"role": "system", "content": "<environment>"},
+    //                                         {"role": "user", "content": "<requirement>"}]}
+    // API2: {"model": "gpt-5-nano", "instructions": "<environment>", "input": "<requirement>", "store": false}
+    class RequestBuilder
+    {
+    public:
+        RequestBuilder(ConfigParser::EngineConfig::InterfaceType interfaceType, std::string const& model, bool store,
+                       bool stream);
+
+        RequestBody Build(std::vector<RequestBody::Segment> const& escapedEnvironment, std::string_view content) const;
+
+    private:
+        RequestBody::Segment m_Prefix;    // JSON up to the opening quote of the environment
+        RequestBody::Segment m_Separator; // from the closing quote of the environment to the opening one of the requirement
+        RequestBody::Segment m_Suffix;    // from the closing quote of the requirement to the end
+    };
+} // namespace AIAssistant
@@ -0,0 +1,208 @@
+/* Copyright (c) 2025 JC Technolabs
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+#include "engine.h"
+#include "json/streamingReply.h"
+
+namespace AIAssistant
+{
+    StreamingReply::StreamingReply(ConfigParser::EngineConfig::InterfaceType interfaceType)
+        : m_InterfaceType(interfaceType)
+    {
+    }
+
+    void StreamingReply::Feed(std::string_view chunk, DeltaCallback const& onDelta)
+    {
+        m_SseParser.Feed(chunk, [&](SseParser::Event const& event) { OnEvent(event, onDelta); });
+    }
+
+    void StreamingReply::OnEvent(SseParser::Event const& event, DeltaCallback const& onDelta)
+    {
+        if (event.m_Data == "[DONE]")
+        {
+            m_Complete = true;
+            return;
+        }
+
+        using namespace simdjson;
+        padded_string json(event.m_Data);
+        ondemand::document doc;
+        auto error = m_JsonParser.iterate(json).get(doc);
+        if (error)
+        {
+            LOG_APP_ERROR("StreamingReply: error parsing event: {}", error_message(error));
+            return;
+        }
+
+        switch (m_InterfaceType)
+        {
+            case ConfigParser::EngineConfig::InterfaceType::API1:
+            {
+                OnEventAPI1(doc, onDelta);
+                break;
+            }
+            case ConfigParser::EngineConfig::InterfaceType::API2:
+            {
+                OnEventAPI2(doc, onDelta);
+                break;
+            }
+            default:
+            {
+                SetError("api not supported");
+                break;
+            }
+        }
+    }
+
+    void StreamingReply::OnEventAPI1(simdjson::ondemand::document& doc, DeltaCallback const& onDelta)
+    {
+        using namespace simdjson;
+
+        ondemand::object errorObject;
+        if (!doc["error"].get(errorObject))
+        {
+            std::string_view message;
+            if (errorObject["message"].get(message))
+            {
+                message = "unknown error";
+            }
+            SetError(message);
+            return;
+        }
+
+        ondemand::array choices;
+        if (!doc["choices"].get(choices))
+        {
+            for (auto choice : choices)
+            {
+                std::string_view content;
+                if (!choice["delta"]["content"].get(content))
+                {
+                    AppendDelta(content, onDelta);
+                }
+            }
+        }
+
+        // only in the final chunk, null elsewhere
+        ondemand::object usage;
+        if (!doc["usage"].get(usage))
+        {
+            ParseUsage(usage);
+        }
+    }
+
+    void StreamingReply::OnEventAPI2(simdjson::ondemand::document& doc, DeltaCallback const& onDelta)
+    {
+        using namespace simdjson;
+
+        std::string_view type;
+        if (doc["type"].get(type))
+        {
+            return;
+        }
+
+        if (type == "response.output_text.delta")
+        {
+            std::string_view delta;
+            if (!doc["delta"].get(delta))
+            {
+                AppendDelta(delta, onDelta);
+            }
+        }
+        else if ((type == "response.completed") || (type == "response.incomplete"))
+        {
+            if (type == "response.incomplete")
+            {
+                LOG_APP_WARN("StreamingReply: response incomplete, output truncated");
+            }
+            ondemand::object usage;
+            if (!doc["response"]["usage"].get(usage))
+            {
+                ParseUsage(usage);
+            }
+            m_Complete = true;
+        }
+        else if ((type == "response.failed") || (type == "error"))
+        {
+            std::string_view message;
+            bool found = (type == "error") ? !doc["message"].get(message)
+                                           : !doc["response"]["error"]["message"].get(message);
+            SetError(found ? message : type);
+        }
+    }
+
+    void StreamingReply::ParseUsage(simdjson::ondemand::object usage)
+    {
+        // API1 and API2 name the same counters differently
+        for (auto field : usage)
+        {
+            std::string_view key;
+            if (field.unescaped_key().get(key))
+            {
+                continue;
+            }
+
+            uint64_t tokens{0};
+            if ((key == "prompt_tokens_details") || (key == "input_tokens_details"))
+            {
+                if (!field.value()["cached_tokens"].get(tokens))
+                {
+                    m_Usage.m_CachedTokens = tokens;
+                }
+            }
+            else if (field.value().get(tokens))
+            {
+                continue; // other detail objects
+            }
+            else if ((key == "prompt_tokens") || (key == "input_tokens"))
+            {
+                m_Usage.m_InputTokens = tokens;
+            }
+            else if ((key == "completion_tokens") || (key == "output_tokens"))
+            {
+                m_Usage.m_OutputTokens = tokens;
+            }
+            else if (key == "total_tokens")
+            {
+                m_Usage.m_TotalTokens = tokens;
+            }
+        }
+    }
+
+    void StreamingReply::AppendDelta(std::string_view delta, DeltaCallback const& onDelta)
+    {
+        if (delta.empty())
+        {
+            return;
+        }
+        m_Content.append(delta);
+        if (onDelta)
+        {
+            onDelta(delta);
+        }
+    }
+
+    void StreamingReply::SetError(std::string_view message)
+    {
+        LOG_APP_ERROR("StreamingReply: {}", message);
+        m_HasError = true;
+    }
+} // namespace AIAssistant
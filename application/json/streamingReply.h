@@ -0,0 +1,81 @@
+/* Copyright (c) 2025 JC Technolabs
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+#pragma once
+#include <functional>
+#include <string>
+#include <string_view>
+
+#include "json/configParser.h"
+#include "json/replyParser.h"
+#include "curlWrapper/sseParser.h"
+#include "simdjson/simdjson.h"
+
+namespace AIAssistant
+{
+    // Reply of a request sent with "stream": true.
+    // Fed with the raw event-stream bytes as curl receives them, it reports
+    // each text delta immediately and accumulates the complete text.
+    //
+    // API1 (chat completions):
+    //   data: {"choices":[{"index":0,"delta":{"content":"Hel"}}], ...}
+    //   data: {"choices":[],"usage":{"prompt_tokens":55, ...}}
+    //   data: [DONE]
+    // API2 (responses):
+    //   event: response.output_text.delta
+    //   data: {"type":"response.output_text.delta","delta":"Hel", ...}
+    //   event: response.completed
+    //   data: {"type":"response.completed","response":{...}}
+    class StreamingReply
+    {
+    public:
+        using DeltaCallback = std::function<void(std::string_view delta)>;
+
+    public:
+        explicit StreamingReply(ConfigParser::EngineConfig::InterfaceType interfaceType);
+
+        void Feed(std::string_view chunk, DeltaCallback const& onDelta);
+
+        bool IsComplete() const { return m_Complete; }
+        bool HasError() const { return m_HasError; }
+        std::string const& GetContent() const { return m_Content; }
+        // API1 only reports usage when the request asked for it with stream_options
+        ReplyParser::Usage const& GetUsage() const { return m_Usage; }
+
+    private:
+        void OnEvent(SseParser::Event const& event, DeltaCallback const& onDelta);
+        void OnEventAPI1(simdjson::ondemand::document& doc, DeltaCallback const& onDelta);
+        void OnEventAPI2(simdjson::ondemand::document& doc, DeltaCallback const& onDelta);
+        void ParseUsage(simdjson::ondemand::object usage);
+        void AppendDelta(std::string_view delta, DeltaCallback const& onDelta);
+        void SetError(std::string_view message);
+
+    private:
+        ConfigParser::EngineConfig::InterfaceType m_InterfaceType;
+        SseParser m_SseParser;
+        simdjson::ondemand::parser m_JsonParser; // reused for every event of the stream
+
+        std::string m_Content;
+        ReplyParser::Usage m_Usage;
+        bool m_Complete{false};
+        bool m_HasError{false};
+    };
+} // namespace AIAssistant
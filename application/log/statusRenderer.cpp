@@ -23,8 +23,11 @@
 
 #include <algorithm>
 #include <array>
+#include <iomanip>
 #include <sstream>
 
+#include "session/usageMetrics.h"
+
 using namespace std::chrono_literals;
 
 namespace AIAssistant
@@ -130,6 +133,16 @@ namespace AIAssistant
 
         outLines.clear();
 
+        UsageMetrics::Snapshot const usage = UsageMetrics::Get().GetSnapshot();
+        auto getSessionTotals = [&usage](std::string const& name) -> UsageMetrics::Totals
+        {
+            auto iterator =
+                std::lower_bound(usage.m_Sessions.begin(), usage.m_Sessions.end(), name,
+                                 [](auto const& element, std::string const& key) { return element.first < key; });
+            return ((iterator != usage.m_Sessions.end()) && (iterator->first == name)) ? iterator->second
+                                                                                        : UsageMetrics::Totals{};
+        };
+
         for (auto const& row : rows)
         {
             std::string const& name = row.first;
@@ -144,8 +157,25 @@ namespace AIAssistant
             std::ostringstream textStream;
             textStream << "[" << name << "] "
                        << "STATE: " << sessionStatus.state << " | Outputs: " << sessionStatus.outputs
-                       << " | In flight: " << sessionStatus.inflight << " | Completed: " << sessionStatus.completed << " "
-                       << spinnerGlyph;
+                       << " | In flight: " << sessionStatus.inflight << " | Completed: " << sessionStatus.completed
+                       << " | Prompt cache: " << std::fixed << std::setprecision(0)
+                       << getSessionTotals(name).GetCachedTokenRate() * 100.0 << "% " << spinnerGlyph;
+
+            std::string lineText = textStream.str();
+            SafeTruncateUtf8(lineText, maxColumns);
+
+            outLines.push_back(std::move(lineText));
+        }
+
+        { // usage of all sessions
+            UsageMetrics::Totals const& total = usage.m_Total;
+
+            std::ostringstream textStream;
+            textStream << "[usage] Queries: " << total.m_Queries << " (" << total.m_CacheHits << " cached, "
+                       << total.m_FailedQueries << " failed) | Tokens in: " << total.m_InputTokens << " ("
+                       << total.m_CachedTokens << " cached) out: " << total.m_OutputTokens << " | Cost: $" << std::fixed
+                       << std::setprecision(4) << total.GetCost() << " | Avg latency: " << std::setprecision(0)
+                       << total.GetAverageLatencyMilliseconds() << " ms";
 
             std::string lineText = textStream.str();
             SafeTruncateUtf8(lineText, maxColumns);
@@ -23,12 +23,16 @@
 #include "pythonEngine.h"
 
 #include <filesystem>
+#include <functional>
 #include <Python.h>
 
+#include "tracy/Tracy.hpp"
+
 #include "log/log.h"
 #include "event/event.h"
 #include "event/filesystemEvent.h"
 #include "event/pythonErrorEvent.h"
+#include "event/eventPool.h"
 
 #include "jarvisAgent.h"
 
@@ -57,7 +61,7 @@ extern "C" void JarvisPyStatus(char const* message)
 
     // stop python
     {
-        auto event = std::make_shared<AIAssistant::PythonCrashedEvent>(message);
+        auto event = AIAssistant::EventPool::Create<AIAssistant::PythonCrashedEvent>(message);
 
         AIAssistant::Core::g_Core->PushEvent(event);
     }
@@ -91,7 +95,7 @@ namespace AIAssistant
     // ============================================================================
     //   Initialize()
     // ============================================================================
-    bool PythonEngine::Initialize(std::string const& scriptPath)
+    bool PythonEngine::Initialize(std::string const& scriptPath, size_t numWorkers)
     {
         if (m_Running)
         {
@@ -100,6 +104,7 @@ namespace AIAssistant
 
         Reset();
         m_StopRequested = false;
+        m_StartPending = false;
         m_ScriptPath = scriptPath;
 
         // Resolve script directory + module name
@@ -242,37 +247,85 @@ namespace AIAssistant
             PyGILState_Release(gilState);
         }
 
-        // Release GIL so worker thread can reacquire it
+        // Release GIL so the worker threads can reacquire it
         PyEval_SaveThread();
 
         m_Running = true;
-        StartWorkerThread();
+        StartWorkers((numWorkers != 0) ? numWorkers : Core::g_Core->GetConfig().m_PythonWorkers);
 
         LOG_APP_INFO("PythonEngine initialized successfully");
         return true;
     }
     // ============================================================================
-    //   Worker thread
+    //   Worker threads
     // ============================================================================
-    void PythonEngine::StartWorkerThread() { m_WorkerThread = std::thread(&PythonEngine::WorkerLoop, this); }
+    void PythonEngine::StartWorkers(size_t numWorkers)
+    {
+        m_Workers.clear();
+        for (size_t workerIndex = 0; workerIndex < numWorkers; ++workerIndex)
+        {
+            m_Workers.push_back(std::make_unique<Worker>());
+        }
+        for (size_t workerIndex = 0; workerIndex < numWorkers; ++workerIndex)
+        {
+            m_Workers[workerIndex]->m_Thread = std::thread(&PythonEngine::WorkerLoop, this, workerIndex);
+        }
+        LOG_APP_INFO("PythonEngine: {} worker threads", numWorkers);
+    }
 
-    void PythonEngine::WorkerLoop()
+    void PythonEngine::StopWorkers()
     {
+        // tasks not yet started are dropped, running hooks are waited for
+        m_StopRequested = true;
+        NotifyWorkers();
+
+        for (auto& worker : m_Workers)
+        {
+            if (worker->m_Thread.joinable())
+            {
+                worker->m_Thread.join();
+            }
+        }
+        m_Workers.clear();
+    }
+
+    void PythonEngine::NotifyWorkers()
+    {
+        for (auto& worker : m_Workers)
+        {
+            {
+                // a worker between checking its condition and waiting would miss the notification
+                std::lock_guard<std::mutex> lock(worker->m_Mutex);
+            }
+            worker->m_Condition.notify_all();
+        }
+    }
+
+    void PythonEngine::WorkerLoop(size_t workerIndex)
+    {
+        tracy::SetThreadName("python worker");
+        Worker& worker = *m_Workers[workerIndex];
+
         while (true)
         {
             PythonTask task;
 
             {
-                std::unique_lock<std::mutex> lock(m_QueueMutex);
-                m_QueueCondition.wait(lock, [&]() { return m_StopRequested || !m_TaskQueue.empty(); });
+                std::unique_lock<std::mutex> lock(worker.m_Mutex);
+                worker.m_Condition.wait(lock,
+                                        [&]()
+                                        {
+                                            return m_StopRequested ||
+                                                   (!worker.m_TaskQueue.empty() && ((workerIndex == 0) || !m_StartPending));
+                                        });
 
                 if (m_StopRequested)
                 {
                     break;
                 }
 
-                task = m_TaskQueue.front();
-                m_TaskQueue.pop();
+                task = std::move(worker.m_TaskQueue.front());
+                worker.m_TaskQueue.pop();
             }
 
             PyGILState_STATE gilState = PyGILState_Ensure();
@@ -305,32 +358,55 @@ namespace AIAssistant
                     }
                     break;
                 }
-
-                case PythonTask::Type::Shutdown:
-                {
-                    if (m_OnShutdownFunc)
-                    {
-                        CallHook(m_OnShutdownFunc, "OnShutdown");
-                    }
-                    break;
-                }
             }
 
             PyGILState_Release(gilState);
+
+            if (task.m_Type == PythonTask::Type::OnStart)
+            {
+                m_StartPending = false;
+                NotifyWorkers();
+            }
         }
     }
 
     // ============================================================================
     //   Enqueue + hook callers
     // ============================================================================
-    void PythonEngine::EnqueueTask(PythonTask const& task)
+    void PythonEngine::EnqueueTask(size_t workerIndex, PythonTask&& task)
+    {
+        Worker& worker = *m_Workers[workerIndex];
+        {
+            std::lock_guard<std::mutex> lock(worker.m_Mutex);
+            worker.m_TaskQueue.push(std::move(task));
+        }
+
+        worker.m_Condition.notify_one();
+    }
+
+    size_t PythonEngine::GetWorkerIndex(Event const& event) const
     {
+        // events without a file, e.g. errors, go to the first worker
+        auto fileSystemEvent = dynamic_cast<FileSystemEvent const*>(&event);
+        if (!fileSystemEvent)
         {
-            std::lock_guard<std::mutex> lock(m_QueueMutex);
-            m_TaskQueue.push(task);
+            return 0;
         }
+        return std::hash<std::string_view>{}(GetDocumentKey(fileSystemEvent->GetPath())) % m_Workers.size();
+    }
 
-        m_QueueCondition.notify_one();
+    std::string_view PythonEngine::GetDocumentKey(std::string_view path)
+    {
+        // "queue/report.pdf", its conversion "queue/report.md" and the output "queue/report.output.md"
+        // all have the key "queue/report"
+        size_t filenameBegin = path.find_last_of('/');
+        filenameBegin = (filenameBegin == std::string_view::npos) ? 0 : filenameBegin + 1;
+        size_t dot = path.find('.', filenameBegin);
+        if ((dot == std::string_view::npos) || (dot == filenameBegin)) // no extension or hidden file
+        {
+            return path;
+        }
+        return path.substr(0, dot);
     }
 
     void PythonEngine::CallHook(PyObject* functionObject, char const* hookName)
@@ -411,9 +487,12 @@ namespace AIAssistant
             return;
         }
 
+        // the other workers hold back their tasks until the hook has run
+        m_StartPending = true;
+
         PythonTask task;
         task.m_Type = PythonTask::Type::OnStart;
-        EnqueueTask(task);
+        EnqueueTask(0, std::move(task));
     }
 
     void PythonEngine::OnUpdate()
@@ -425,7 +504,7 @@ namespace AIAssistant
 
         PythonTask task;
         task.m_Type = PythonTask::Type::OnUpdate;
-        EnqueueTask(task);
+        EnqueueTask(0, std::move(task));
     }
 
     void PythonEngine::OnEvent(std::shared_ptr<Event> eventPtr)
@@ -435,10 +514,17 @@ namespace AIAssistant
             return;
         }
 
+        if (!eventPtr)
+        {
+            return;
+        }
+
+        size_t workerIndex = GetWorkerIndex(*eventPtr);
+
         PythonTask task;
         task.m_Type = PythonTask::Type::OnEvent;
         task.m_EventPtr = std::move(eventPtr);
-        EnqueueTask(task);
+        EnqueueTask(workerIndex, std::move(task));
     }
 
     // ============================================================================
@@ -451,25 +537,17 @@ namespace AIAssistant
             return;
         }
 
-        // enqueue the Shutdown hook so Python gets a clean callback
-        if (m_OnShutdownFunc)
-        {
-            PythonTask task;
-            task.m_Type = PythonTask::Type::Shutdown;
-            EnqueueTask(task);
-        }
+        StopWorkers();
 
-        // tell the worker thread to stop
-        m_StopRequested = true;
-        m_QueueCondition.notify_all();
+        // no worker is left to run it, Python gets its clean callback here
+        PyGILState_STATE gilState = PyGILState_Ensure();
 
-        if (m_WorkerThread.joinable())
+        if (m_OnShutdownFunc)
         {
-            m_WorkerThread.join();
+            CallHook(m_OnShutdownFunc, "OnShutdown");
         }
 
         // clean up Python references safely under the GIL
-        PyGILState_STATE gilState = PyGILState_Ensure();
 
         Py_XDECREF(m_OnStartFunc);
         Py_XDECREF(m_OnUpdateFunc);
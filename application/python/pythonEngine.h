@@ -21,11 +21,14 @@
 
 #pragma once
 
+#include <atomic>
 #include <string>
+#include <string_view>
 #include <queue>
 #include <thread>
 #include <mutex>
 #include <memory>
+#include <vector>
 #include <condition_variable>
 
 // Forward declaration to avoid including Python headers here
@@ -42,21 +45,27 @@ namespace AIAssistant
         {
             OnStart,
             OnUpdate,
-            OnEvent,
-            Shutdown
+            OnEvent
         };
 
         Type m_Type{};
         std::shared_ptr<Event> m_EventPtr;
     };
 
+    // Runs the hooks of a Python script on a pool of worker threads. Every worker has its own
+    // queue, and events are routed by document key (folder and file name up to the first dot),
+    // so "report.pdf", "report.md" and "report.output.md" are handled in order by one worker while
+    // other documents are handled in parallel. The hooks share one interpreter and take turns on
+    // the GIL. Conversions run markitdown as a child process and release the GIL while they wait,
+    // so several documents convert at the same time on different cores.
     class PythonEngine
     {
     public:
         PythonEngine();
         ~PythonEngine();
 
-        bool Initialize(std::string const& scriptPath);
+        // numWorkers: 0 takes "python workers" from the config
+        bool Initialize(std::string const& scriptPath, size_t numWorkers = 0);
         void Stop();
 
         void OnStart();
@@ -72,14 +81,28 @@ namespace AIAssistant
         void CallHookWithEvent(PyObject* function, char const* hookName, Event const& event);
         PyObject* BuildEventDict(Event const& event);
 
-        // Worker
-        void StartWorkerThread();
-        void WorkerLoop();
-        void EnqueueTask(PythonTask const& task);
+        // Workers
+        void StartWorkers(size_t numWorkers);
+        void StopWorkers();
+        void NotifyWorkers();
+        void WorkerLoop(size_t workerIndex);
+        void EnqueueTask(size_t workerIndex, PythonTask&& task);
+        size_t GetWorkerIndex(Event const& event) const;
+        static std::string_view GetDocumentKey(std::string_view path);
+
+    private:
+        struct Worker
+        {
+            std::thread m_Thread;
+            std::mutex m_Mutex;
+            std::condition_variable m_Condition;
+            std::queue<PythonTask> m_TaskQueue;
+        };
 
     private:
         bool m_Running{false};
-        bool m_StopRequested{false};
+        std::atomic<bool> m_StopRequested{false};
+        std::atomic<bool> m_StartPending{false}; // OnStart() runs on the first worker, the others wait for it
 
         std::string m_ScriptPath;
         std::string m_ScriptDir;
@@ -93,10 +116,7 @@ namespace AIAssistant
         PyObject* m_OnEventFunc{nullptr};
         PyObject* m_OnShutdownFunc{nullptr};
 
-        std::thread m_WorkerThread;
-        std::mutex m_QueueMutex;
-        std::condition_variable m_QueueCondition;
-        std::queue<PythonTask> m_TaskQueue;
+        std::vector<std::unique_ptr<Worker>> m_Workers;
     };
 
 } // namespace AIAssistant
@@ -76,22 +76,56 @@ namespace AIAssistant
                 return;
             }
 
-            out << "# Generated by JarvisAgent\n";
-            out << "# Model: " << model << "\n";
+            WriteHeader(out, model, appendTimestamp);
+            out << content;
+            LOG_APP_INFO("FileWriter: Wrote output file with header: {}", filePath.string());
+        }
+        catch (const std::exception& e)
+        {
+            LOG_APP_ERROR("FileWriter: Exception writing file '{}': {}", filePath.string(), e.what());
+        }
+    }
+
+    std::unique_ptr<std::ofstream> FileWriter::OpenWithHeader(fs::path const& filePath, std::string const& model,
+                                                              bool appendTimestamp)
+    {
+        std::lock_guard<std::mutex> guard(m_Mutex);
 
-            if (appendTimestamp)
+        try
+        {
+            fs::create_directories(filePath.parent_path());
+            auto out = std::make_unique<std::ofstream>(filePath, std::ios::out | std::ios::trunc);
+
+            if (!*out)
             {
-                auto now = std::chrono::system_clock::now();
-                auto time = std::chrono::system_clock::to_time_t(now);
-                out << "# Timestamp: " << std::put_time(std::localtime(&time), "%Y-%m-%d %H:%M:%S") << "\n";
+                LOG_APP_ERROR("FileWriter: Could not open file for writing: {}", filePath.string());
+                return nullptr;
             }
 
-            out << "\n" << content;
-            LOG_APP_INFO("FileWriter: Wrote output file with header: {}", filePath.string());
+            WriteHeader(*out, model, appendTimestamp);
+            out->flush();
+            LOG_APP_INFO("FileWriter: Streaming output file: {}", filePath.string());
+            return out;
         }
         catch (const std::exception& e)
         {
-            LOG_APP_ERROR("FileWriter: Exception writing file '{}': {}", filePath.string(), e.what());
+            LOG_APP_ERROR("FileWriter: Exception opening file '{}': {}", filePath.string(), e.what());
+            return nullptr;
+        }
+    }
+
+    void FileWriter::WriteHeader(std::ostream& out, std::string const& model, bool appendTimestamp)
+    {
+        out << "# Generated by JarvisAgent\n";
+        out << "# Model: " << model << "\n";
+
+        if (appendTimestamp)
+        {
+            auto now = std::chrono::system_clock::now();
+            auto time = std::chrono::system_clock::to_time_t(now);
+            out << "# Timestamp: " << std::put_time(std::localtime(&time), "%Y-%m-%d %H:%M:%S") << "\n";
         }
+
+        out << "\n";
     }
 } // namespace AIAssistant
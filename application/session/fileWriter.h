@@ -23,6 +23,8 @@
 #include <string>
 #include <mutex>
 #include <filesystem>
+#include <fstream>
+#include <memory>
 
 namespace AIAssistant
 {
@@ -35,6 +37,10 @@ namespace AIAssistant
         void WriteWithHeader(std::filesystem::path const& filePath, std::string const& content, std::string const& model,
                              bool appendTimestamp = true);
 
+        // writes the header and returns the open file, content is appended as it arrives (streaming replies)
+        std::unique_ptr<std::ofstream> OpenWithHeader(std::filesystem::path const& filePath, std::string const& model,
+                                                      bool appendTimestamp = true);
+
     private:
         FileWriter() = default;
         ~FileWriter() = default;
@@ -42,6 +48,8 @@ namespace AIAssistant
         FileWriter(const FileWriter&) = delete;
         FileWriter& operator=(const FileWriter&) = delete;
 
+        static void WriteHeader(std::ostream& out, std::string const& model, bool appendTimestamp);
+
     private:
         std::mutex m_Mutex;
     };
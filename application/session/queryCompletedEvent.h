@@ -0,0 +1,53 @@
+/* Copyright (c) 2025 JC Technolabs
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+#pragma once
+#include <memory>
+
+#include "event/event.h"
+#include "event/pathTable.h"
+#include "session/queryResult.h"
+
+namespace AIAssistant
+{
+    // Posted from the thread pool when a query's reply has been parsed,
+    // routed by JarvisAgent to the session that dispatched it.
+    class QueryCompletedEvent : public Event
+    {
+    public:
+        QueryCompletedEvent(PathTable::Entry session, std::shared_ptr<QueryResult> result, bool ok)
+            : m_Session{session}, m_Result{std::move(result)}, m_Ok{ok}
+        {
+        }
+
+        std::string const& GetSessionName() const { return *m_Session.m_Path; }
+        std::shared_ptr<QueryResult> const& GetResult() const { return m_Result; }
+        bool IsOk() const { return m_Ok; } // false: curl or the reply failed
+
+        EVENT_CLASS_TYPE(QueryCompleted)
+        EVENT_CLASS_CATEGORY(EventCategoryApp)
+
+    private:
+        PathTable::Entry m_Session; // session name, interned
+        std::shared_ptr<QueryResult> m_Result;
+        bool m_Ok;
+    };
+} // namespace AIAssistant
@@ -0,0 +1,75 @@
+/* Copyright (c) 2025 JC Technolabs
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+#pragma once
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "auxiliary/hash.h"
+#include "json/replyParser.h"
+
+namespace fs = std::filesystem;
+
+namespace AIAssistant
+{
+    // Everything one query produced. Filled on the thread pool once the reply has arrived,
+    // consumed on the main thread by SessionManager::CompleteQueries, which writes
+    // the output files. Owns all its data, nothing points into the reply parser.
+    struct QueryResult
+    {
+        enum class Status
+        {
+            Pending = 0,
+            Ok,
+            NetworkError, // curl failed, no reply
+            ReplyError,   // the API answered with an error object or unparsable JSON
+            NoContent,
+            Incomplete // a streamed reply ended early
+        };
+
+        // set at dispatch
+        uint64_t m_Sequence{0}; // dispatch order within the session
+        std::string m_InputFilename;
+        EngineCore::Digest m_InputHash;
+        EngineCore::Digest m_EnvironmentHash;
+        EngineCore::Digest m_CacheKey;
+        std::chrono::steady_clock::time_point m_DispatchTime;
+        // chunk of a large Markdown document, the reply is one part of the document's output
+        size_t m_ChunkIndex{0};
+        size_t m_ChunkCount{0}; // 0: not a chunk
+
+        // set on completion
+        Status m_Status{Status::Pending};
+        std::vector<std::string> m_Content; // content blocks
+        ReplyParser::Usage m_Usage;
+        double m_EstimatedCost{0.0}; // USD, see UsageMetrics
+        long m_HttpStatus{0};
+        std::string m_ErrorMessage;
+        std::chrono::steady_clock::duration m_Latency{};
+        fs::path m_StreamedOutput; // complete reply streamed here, moved over the output by CompleteQuery
+        bool m_FromCache{false};   // answered by the response cache, no usage
+
+        bool IsOk() const { return m_Status == Status::Ok; }
+        bool IsChunk() const { return m_ChunkCount != 0; }
+    };
+} // namespace AIAssistant
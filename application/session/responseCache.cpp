@@ -0,0 +1,367 @@
+/* Copyright (c) 2025 JC Technolabs
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+#include <cstring>
+#include <algorithm>
+#include <fstream>
+
+#include "engine.h"
+#include "session/responseCache.h"
+
+namespace AIAssistant
+{
+    // --- entry file format ---
+    // magic | version (u32) | block count (u32) | blocks
+    // block: length (u64) | content
+
+    ResponseCache& ResponseCache::Get()
+    {
+        static ResponseCache instance;
+        return instance;
+    }
+
+    void ResponseCache::Load(fs::path const& cacheFolder, size_t maxBytes, std::chrono::hours timeToLive)
+    {
+        std::lock_guard lock(m_Mutex);
+        m_CacheFolder = cacheFolder;
+        m_MaxBytes = maxBytes;
+        m_TimeToLive = timeToLive;
+        m_Entries.clear();
+        m_LruList.clear();
+        m_TotalBytes = 0;
+
+        if (m_MaxBytes == 0)
+        {
+            LOG_APP_INFO("ResponseCache: disabled");
+            return;
+        }
+
+        std::error_code errorCode;
+        fs::create_directories(m_CacheFolder, errorCode);
+
+        // the file's mtime is its creation time, entries are never rewritten
+        auto now = Clock::now();
+        size_t found{0};
+        std::vector<std::pair<std::string, Entry>> entries;
+        for (auto const& directoryEntry : fs::directory_iterator(m_CacheFolder, errorCode))
+        {
+            std::error_code entryError;
+            if (!directoryEntry.is_regular_file(entryError))
+            {
+                continue;
+            }
+            if (directoryEntry.path().extension() == ".tmp")
+            {
+                // left by an insert that did not finish, nothing else writes here yet
+                fs::remove(directoryEntry.path(), entryError);
+                continue;
+            }
+            if (directoryEntry.path().extension() != ".bin")
+            {
+                continue;
+            }
+            auto lastWriteTime = directoryEntry.last_write_time(entryError);
+            auto size = directoryEntry.file_size(entryError);
+            if (entryError)
+            {
+                continue;
+            }
+            ++found;
+
+            Entry entry;
+            entry.m_Size = static_cast<size_t>(size);
+            entry.m_Created = lastWriteTime;
+            if (IsExpired(entry, now))
+            {
+                fs::remove(directoryEntry.path(), entryError);
+                continue;
+            }
+            entries.emplace_back(directoryEntry.path().stem().string(), entry);
+        }
+
+        // usage is not persisted, the newest entries count as most recently used
+        std::sort(entries.begin(), entries.end(),
+                  [](auto const& lhs, auto const& rhs) { return lhs.second.m_Created > rhs.second.m_Created; });
+        for (auto& [keyHex, entry] : entries)
+        {
+            entry.m_LruPosition = m_LruList.insert(m_LruList.end(), keyHex);
+            m_TotalBytes += entry.m_Size;
+            m_Entries.emplace(keyHex, entry);
+        }
+
+        for (auto const& keyHex : EvictOverBudget())
+        {
+            fs::remove(GetEntryFilepath(keyHex), errorCode);
+        }
+        LOG_APP_INFO("ResponseCache: {} entries ({} kB) in '{}', {} expired or evicted", m_Entries.size(),
+                     m_TotalBytes / 1024, m_CacheFolder.string(), found - m_Entries.size());
+    }
+
+    bool ResponseCache::IsEnabled() const
+    {
+        std::lock_guard lock(m_Mutex);
+        return m_MaxBytes > 0;
+    }
+
+    EngineCore::Digest ResponseCache::MakeKey(std::string_view url, std::string_view model,
+                                              ConfigParser::EngineConfig::InterfaceType interfaceType,
+                                              EngineCore::Digest const& environmentDigest, std::string_view content)
+    {
+        // independent of "hash algorithm": a collision here would return a wrong answer;
+        // the environment enters as its digest, only the requirement content is hashed per query
+        EngineCore::Hasher hasher(EngineCore::HashAlgorithm::Sha256);
+        hasher.Update(url.data(), url.size());
+        hasher.Update("\n", 1);
+        hasher.Update(model.data(), model.size());
+        hasher.Update("\n", 1);
+        auto interfaceId = static_cast<uint32_t>(interfaceType);
+        hasher.Update(&interfaceId, sizeof(interfaceId));
+        hasher.Update(environmentDigest.m_Bytes.data(), environmentDigest.m_Size);
+        hasher.Update(content.data(), content.size());
+        return hasher.Finalize();
+    }
+
+    bool ResponseCache::Contains(EngineCore::Digest const& key) const
+    {
+        std::lock_guard lock(m_Mutex);
+        if (m_MaxBytes == 0)
+        {
+            return false;
+        }
+        // an expired entry is replaced by the insert of the fresh reply
+        auto entry = m_Entries.find(key.ToHex());
+        return (entry != m_Entries.end()) && !IsExpired(entry->second, Clock::now());
+    }
+
+    std::optional<ResponseCache::Contents> ResponseCache::Lookup(EngineCore::Digest const& key)
+    {
+        std::string keyHex = key.ToHex();
+        fs::path entryFilepath;
+        size_t entrySize{0};
+        Clock::time_point entryCreated;
+        bool expired{false};
+        {
+            std::lock_guard lock(m_Mutex);
+            if (m_MaxBytes == 0)
+            {
+                return std::nullopt;
+            }
+
+            auto entry = m_Entries.find(keyHex);
+            if (entry == m_Entries.end())
+            {
+                return std::nullopt;
+            }
+
+            expired = IsExpired(entry->second, Clock::now());
+            if (expired)
+            {
+                RemoveEntry(keyHex);
+            }
+            else
+            {
+                entryFilepath = GetEntryFilepath(keyHex);
+                entrySize = entry->second.m_Size;
+                entryCreated = entry->second.m_Created;
+            }
+        }
+        if (expired)
+        {
+            RemoveUnregisteredFiles({keyHex});
+            return std::nullopt;
+        }
+
+        // an entry evicted meanwhile stays readable through the open file
+        std::ifstream file(entryFilepath, std::ios::binary);
+        char magic[sizeof(MAGIC)]{};
+        uint32_t version{0};
+        uint32_t blockCount{0};
+        bool ok = file.read(magic, sizeof(MAGIC)) && (std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0) &&
+                  file.read(reinterpret_cast<char*>(&version), sizeof(version)) && (version == VERSION) &&
+                  file.read(reinterpret_cast<char*>(&blockCount), sizeof(blockCount));
+
+        Contents contents;
+        for (uint32_t index = 0; ok && (index < blockCount); ++index)
+        {
+            uint64_t length{0};
+            ok = file.read(reinterpret_cast<char*>(&length), sizeof(length)) && (length <= entrySize);
+            if (ok)
+            {
+                std::string& content = contents.emplace_back(length, '\0');
+                ok = static_cast<bool>(file.read(content.data(), static_cast<std::streamsize>(length)));
+            }
+        }
+
+        bool unreadable{false};
+        {
+            std::lock_guard lock(m_Mutex);
+            auto entry = m_Entries.find(keyHex);
+            if (entry != m_Entries.end())
+            {
+                if (ok)
+                {
+                    m_LruList.splice(m_LruList.begin(), m_LruList, entry->second.m_LruPosition);
+                }
+                else if (entry->second.m_Created == entryCreated)
+                {
+                    // not when it was evicted and inserted again while being read
+                    LOG_APP_WARN("ResponseCache: dropping unreadable entry '{}'", keyHex);
+                    RemoveEntry(keyHex);
+                    unreadable = true;
+                }
+            }
+        }
+        if (unreadable)
+        {
+            RemoveUnregisteredFiles({keyHex});
+        }
+        if (!ok)
+        {
+            return std::nullopt;
+        }
+        return contents;
+    }
+
+    void ResponseCache::Insert(EngineCore::Digest const& key, Contents const& contents)
+    {
+        std::string keyHex = key.ToHex();
+        size_t maxBytes{0};
+        fs::path entryFilepath;
+        {
+            std::lock_guard lock(m_Mutex);
+            maxBytes = m_MaxBytes;
+            entryFilepath = GetEntryFilepath(keyHex);
+        }
+        if (maxBytes == 0)
+        {
+            return;
+        }
+
+        std::string buffer;
+        buffer.append(MAGIC, sizeof(MAGIC));
+        uint32_t version = VERSION;
+        buffer.append(reinterpret_cast<char const*>(&version), sizeof(version));
+        uint32_t blockCount = static_cast<uint32_t>(contents.size());
+        buffer.append(reinterpret_cast<char const*>(&blockCount), sizeof(blockCount));
+        for (auto const& content : contents)
+        {
+            uint64_t length = content.size();
+            buffer.append(reinterpret_cast<char const*>(&length), sizeof(length));
+            buffer.append(content);
+        }
+
+        if (buffer.size() > maxBytes)
+        {
+            return;
+        }
+
+        // write to a temporary file and rename it, so a crash never leaves a half-written entry
+        fs::path temporaryFilepath = entryFilepath;
+        temporaryFilepath += "." + std::to_string(m_TemporaryFileCounter.fetch_add(1)) + ".tmp";
+        {
+            std::ofstream out(temporaryFilepath, std::ios::binary | std::ios::trunc);
+            if (!out || !out.write(buffer.data(), static_cast<std::streamsize>(buffer.size())))
+            {
+                LOG_APP_ERROR("ResponseCache: could not write '{}'", temporaryFilepath.string());
+                return;
+            }
+        }
+        std::vector<std::string> evicted;
+        {
+            // renamed and registered in one step: a concurrent removal of this key either runs
+            // before, or sees it registered and keeps the file
+            std::lock_guard lock(m_Mutex);
+            std::error_code errorCode;
+            fs::rename(temporaryFilepath, entryFilepath, errorCode);
+            if (errorCode)
+            {
+                LOG_APP_ERROR("ResponseCache: could not replace '{}': {}", entryFilepath.string(),
+                              errorCode.message());
+                fs::remove(temporaryFilepath, errorCode);
+                return;
+            }
+
+            auto [entry, inserted] = m_Entries.try_emplace(keyHex);
+            if (inserted)
+            {
+                entry->second.m_LruPosition = m_LruList.insert(m_LruList.begin(), keyHex);
+            }
+            else
+            {
+                m_TotalBytes -= entry->second.m_Size;
+                m_LruList.splice(m_LruList.begin(), m_LruList, entry->second.m_LruPosition);
+            }
+            entry->second.m_Size = buffer.size();
+            entry->second.m_Created = Clock::now();
+            m_TotalBytes += buffer.size();
+
+            if (m_TotalBytes > m_MaxBytes)
+            {
+                evicted = EvictOverBudget();
+            }
+        }
+        RemoveUnregisteredFiles(evicted);
+    }
+
+    fs::path ResponseCache::GetEntryFilepath(std::string const& keyHex) const { return m_CacheFolder / (keyHex + ".bin"); }
+
+    bool ResponseCache::IsExpired(Entry const& entry, Clock::time_point now) const
+    {
+        return (m_TimeToLive.count() > 0) && (now - entry.m_Created > m_TimeToLive);
+    }
+
+    void ResponseCache::RemoveEntry(std::string const& keyHex)
+    {
+        auto entry = m_Entries.find(keyHex);
+        if (entry == m_Entries.end())
+        {
+            return;
+        }
+        m_TotalBytes -= entry->second.m_Size;
+        m_LruList.erase(entry->second.m_LruPosition);
+        m_Entries.erase(entry);
+    }
+
+    std::vector<std::string> ResponseCache::EvictOverBudget()
+    {
+        std::vector<std::string> evicted;
+        while ((m_TotalBytes > m_MaxBytes) && !m_LruList.empty())
+        {
+            evicted.push_back(m_LruList.back());
+            RemoveEntry(evicted.back());
+        }
+        return evicted;
+    }
+
+    void ResponseCache::RemoveUnregisteredFiles(std::vector<std::string> const& keys)
+    {
+        for (auto const& keyHex : keys)
+        {
+            // an insert renames its file into place under the mutex, it can't slip in between
+            std::lock_guard lock(m_Mutex);
+            if (!m_Entries.contains(keyHex))
+            {
+                std::error_code errorCode;
+                fs::remove(GetEntryFilepath(keyHex), errorCode);
+            }
+        }
+    }
+} // namespace AIAssistant
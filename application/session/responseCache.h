@@ -0,0 +1,116 @@
+/* Copyright (c) 2025 JC Technolabs
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "auxiliary/hash.h"
+#include "json/configParser.h"
+
+namespace fs = std::filesystem;
+
+namespace AIAssistant
+{
+    // Persistent, content-addressed cache of LLM replies.
+    // The key is a SHA-256 over the endpoint, model, API type, the digest of
+    // the escaped environment and the requirement content. A hit lets the
+    // session write the output without a network round trip.
+    // One file per entry in the hidden state folder of the queue. Entries
+    // expire after a TTL, and the least recently used ones are evicted when
+    // the cache grows beyond its size limit.
+    // Entry files are read and written outside the mutex; renaming one into
+    // place and removing one happen under it, checked against the bookkeeping.
+    // Contains() only looks at the in-memory index and is cheap enough for the
+    // main thread, Lookup() reads the entry file and belongs on the thread pool.
+    class ResponseCache
+    {
+    public:
+        using Contents = std::vector<std::string>; // content blocks as returned by the reply parser
+
+    public:
+        static ResponseCache& Get();
+
+        // maxBytes == 0 disables the cache
+        void Load(fs::path const& cacheFolder, size_t maxBytes, std::chrono::hours timeToLive);
+        bool IsEnabled() const;
+
+        // environmentDigest: SHA-256 of the escaped environment, taken once per environment version
+        static EngineCore::Digest MakeKey(std::string_view url, std::string_view model,
+                                          ConfigParser::EngineConfig::InterfaceType interfaceType,
+                                          EngineCore::Digest const& environmentDigest, std::string_view content);
+
+        bool Contains(EngineCore::Digest const& key) const; // registered and not expired, no file access
+        std::optional<Contents> Lookup(EngineCore::Digest const& key);
+        void Insert(EngineCore::Digest const& key, Contents const& contents);
+
+    private:
+        ResponseCache() = default;
+        ~ResponseCache() = default;
+
+        ResponseCache(const ResponseCache&) = delete;
+        ResponseCache& operator=(const ResponseCache&) = delete;
+
+    private:
+        using Clock = fs::file_time_type::clock; // compares directly with file mtimes
+
+        using LruList = std::list<std::string>; // hex digests, most recently used first
+
+        struct Entry
+        {
+            size_t m_Size{0};
+            Clock::time_point m_Created;
+            LruList::iterator m_LruPosition;
+        };
+
+        fs::path GetEntryFilepath(std::string const& keyHex) const;
+        bool IsExpired(Entry const& entry, Clock::time_point now) const;
+        // drops the bookkeeping, the file stays until RemoveUnregisteredFiles()
+        void RemoveEntry(std::string const& keyHex);
+        // least recently used entries until the cache fits its size limit, returns their keys
+        std::vector<std::string> EvictOverBudget();
+        // takes the mutex per file, skips keys that were inserted again meanwhile
+        void RemoveUnregisteredFiles(std::vector<std::string> const& keys);
+
+    private:
+        static constexpr char MAGIC[4] = {'J', 'A', 'R', 'C'};
+        static constexpr uint32_t VERSION = 1;
+
+        fs::path m_CacheFolder;
+        size_t m_MaxBytes{0};
+        std::chrono::hours m_TimeToLive{0};
+
+        std::unordered_map<std::string, Entry> m_Entries; // key: hex digest
+        LruList m_LruList;
+        size_t m_TotalBytes{0};
+        std::atomic<uint64_t> m_TemporaryFileCounter{0}; // concurrent inserts of one key write separate files
+        mutable std::mutex m_Mutex;
+    };
+} // namespace AIAssistant
@@ -21,29 +21,46 @@
 
 #include "session/sessionManager.h"
 #include "session/fileWriter.h"
+#include "session/responseCache.h"
 #include "web/webServer.h"
+#include "web/chatMessages.h"
+#include "json/streamingReply.h"
+#include "file/probUtils.h"
+#include "file/markdownChunker.h"
 
 #include "core.h"
 #include "event/events.h"
 #include "json/jsonHelper.h"
 #include "log/statusRenderer.h"
 #include "auxiliary/file.h"
+#include "auxiliary/hash.h"
+#include "file/fileHashIndex.h"
+#include "session/queryCompletedEvent.h"
 
 namespace AIAssistant
 {
-    SessionManager::SessionManager(std::string const& filePath) : m_Name{filePath}
+    SessionManager::SessionManager(std::string const& filePath)
+        : m_Name{filePath}, m_NameEntry{PathTable::Get().Intern(filePath)}
     {
         auto apiIndex = Core::g_Core->GetConfig().m_ApiIndex;
         auto& api = Core::g_Core->GetConfig().m_ApiInterfaces[apiIndex];
 
         m_Url = api.m_Url;
         m_Model = api.m_Model;
+        m_ApiInterface = api;
+
+        m_SessionCounters = UsageMetrics::Get().GetSessionCounters(m_Name);
+        m_ModelCounters = UsageMetrics::Get().GetModelCounters(m_Model);
+
+        bool store{false};
+        m_RequestBuilder = std::make_unique<RequestBuilder>(api.m_InterfaceType, m_Model, store,
+                                                            Core::g_Core->GetConfig().m_StreamResponses);
     }
 
     void SessionManager::OnUpdate()
     {
         CheckForUpdates();
-        TrackInFlightQueries();
+        CompleteQueries();
 
         { // update statemachine
             auto& requirements = m_FileCategorizer.GetCategorizedFiles().m_Requirements;
@@ -55,40 +72,30 @@ namespace AIAssistant
                 .m_EnvironmentComplete = m_Environment.GetEnvironmentComplete(), //
                 .m_QueriesChanged = queriesChanged,                              //
                 .m_AllQueriesSent = allQueriesSent,                              //
-                .m_AllResponsesReceived = (m_QueryFutures.size() == 0)           // idle when no futures are outstanding
+                .m_AllResponsesReceived = (m_InFlightQueries == 0)               // idle when no queries are outstanding
             };
             m_StateMachine.OnUpdate(stateInfo);
         }
 
-        // limit queued queries to 1½ the number of configured threads
-        // thread pool has queue but we can limit it here to safe queue memory
-        if ((m_QueryFutures.size() < Core::g_Core->GetConfig().m_MaxThreads * 1.5f) &&
-            m_Environment.GetEnvironmentComplete())
+        if (m_Environment.GetEnvironmentComplete())
         {
-            bool anyQueryDispatched = false;
-            auto& map = m_FileCategorizer.GetCategorizedFiles().m_Requirements.Get();
-            for (auto& element : map)
+            // chat questions go first and are exempt from the limit below, a user is waiting for them;
+            // the interactive lane of the curl multi engine takes them past queries already queued
+            bool anyQueryDispatched = DispatchInteractiveRequirements();
+
+            // limit queued queries to 1½ the number of concurrent queries
+            // the curl multi engine has a queue but we can limit it here to save queue memory
+            if (m_InFlightQueries < Core::g_Core->GetConfig().m_MaxConcurrentQueries * 1.5f)
             {
-                auto& trackedFile = *element.second;
-                if (trackedFile.IsModified())
+                anyQueryDispatched |= DispatchRequirements();
+
+                // If environment was dirty but no queries needed to run, reset it
+                if (!anyQueryDispatched && m_Environment.GetDirty())
                 {
-                    if (IsQueryRequired(trackedFile))
-                    {
-                        DispatchQuery(trackedFile);
-                        anyQueryDispatched = true;
-                    }
-                    trackedFile.MarkModified(false);
-                    auto& requirements = m_FileCategorizer.GetCategorizedFiles().m_Requirements;
-                    requirements.DecrementModifiedFiles();
+                    LOG_APP_INFO("All outputs up-to-date → resetting environment dirty flag");
+                    m_Environment.SetDirty(false);
                 }
             }
-
-            // If environment was dirty but no queries needed to run, reset it
-            if (!anyQueryDispatched && m_Environment.GetDirty())
-            {
-                LOG_APP_INFO("All outputs up-to-date → resetting environment dirty flag");
-                m_Environment.SetDirty(false);
-            }
         }
 
         { // status display in terminal (ncurses status panel)
@@ -98,7 +105,7 @@ namespace AIAssistant
                 StatusRenderer& statusRenderer = jarvisAgent->GetStatusRenderer();
                 statusRenderer.UpdateSession(m_Name, SessionManager::StateMachine::StateNames[m_StateMachine.GetState()],
                                              m_FileCategorizer.GetCategorizedFiles().m_Requirements.m_Map.size(),
-                                             m_QueryFutures.size(), m_CompletedQueriesThisRun);
+                                             m_InFlightQueries, m_CompletedQueriesThisRun);
             }
         }
 
@@ -109,7 +116,7 @@ namespace AIAssistant
             msg["name"] = m_Name;
             msg["state"] = std::string(SessionManager::StateMachine::StateNames[m_StateMachine.GetState()]);
             msg["outputs"] = m_FileCategorizer.GetCategorizedFiles().m_Requirements.m_Map.size();
-            msg["inflight"] = m_QueryFutures.size();
+            msg["inflight"] = m_InFlightQueries;
             msg["completed"] = m_CompletedQueriesThisRun;
             webServer.BroadcastJSON(msg.dump());
         }
@@ -117,10 +124,8 @@ namespace AIAssistant
 
     bool SessionManager::IsQueryRequired(TrackedFile& requirementFile) const
     {
-
-        fs::path requirementPath = requirementFile.GetPath();
-        fs::path outputPath = requirementPath;
-        outputPath.replace_filename(requirementPath.stem().string() + ".output" + requirementPath.extension().string());
+        fs::path const& requirementPath = requirementFile.GetPath();
+        fs::path outputPath = GetOutputPath(requirementPath.string());
 
         try
         {
@@ -131,22 +136,39 @@ namespace AIAssistant
                 return false;
             }
 
+            // Index knows which input content and environment the output was generated from:
+            // exact, and independent of timestamps (touched or restored files)
+            std::optional<bool> outputUpToDate =
+                FileHashIndex::Get().IsOutputUpToDate(requirementFile.GetHash(), m_Environment.GetHash(), outputPath);
+            if (outputUpToDate.has_value())
+            {
+                if (outputUpToDate.value())
+                {
+                    LOG_APP_INFO("Skipping '{}': output matches input and environment", requirementPath.string());
+                    return false;
+                }
+                LOG_APP_INFO("Re-scheduling '{}': output outdated or missing", requirementPath.string());
+                return true;
+            }
+
             // If no output yet, definitely re-send
-            if (!fs::exists(outputPath))
+            EngineCore::FileStat outputStat;
+            if (!EngineCore::GetFileStat(outputPath, outputStat))
             {
                 LOG_APP_INFO("No output found for '{}', scheduling query", requirementPath.string());
                 return true;
             }
 
-            auto requirementTime = fs::last_write_time(requirementPath);
-            auto environmentTime = m_Environment.GetTimestamp();
+            // nothing recorded: output of an older version or edited by hand, fall back to
+            // times as stat() reports them, the environment keeps the newest time of its files
+            int64_t requirementTime = requirementFile.GetFileStat().m_LastWriteTime;
+            int64_t environmentTime = m_Environment.GetLastWriteTime();
 
             // Determine the newest relevant input time
-            auto newestInputTime = (requirementTime > environmentTime) ? requirementTime : environmentTime;
-            auto outputTime = fs::last_write_time(outputPath);
+            auto newestInputTime = std::max(requirementTime, environmentTime);
 
             // Re-send if input newer than output
-            if (newestInputTime > outputTime)
+            if (newestInputTime > outputStat.m_LastWriteTime)
             {
                 LOG_APP_INFO("Re-scheduling '{}': input/environment newer than output", requirementPath.string());
                 return true;
@@ -168,11 +190,26 @@ namespace AIAssistant
         EventDispatcher dispatcher(event);
         fs::path filePath;
 
+        dispatcher.Dispatch<QueryCompletedEvent>(
+            [&](QueryCompletedEvent& queryEvent)
+            {
+                --m_InFlightQueries;
+                // report bad curl to engine
+                if (!queryEvent.IsOk())
+                {
+                    auto appErrorEvent = EventPool::Create<AppErrorEvent>(AppErrorEvent::AppErrorBadCurl);
+                    Core::g_Core->PushEvent(appErrorEvent);
+                }
+                m_CompletedQueries.push_back(queryEvent.GetResult());
+                return true;
+            });
+
         dispatcher.Dispatch<FileAddedEvent>(
             [&](FileAddedEvent& fileEvent)
             {
                 LOG_APP_INFO("New file detected: {}", fileEvent.GetPath());
                 filePath = m_FileCategorizer.AddFile(fileEvent.GetPath());
+                NoteInteractive(filePath);
                 return true;
             });
 
@@ -181,6 +218,7 @@ namespace AIAssistant
             {
                 LOG_APP_INFO("File modified: {}", fileEvent.GetPath());
                 filePath = m_FileCategorizer.ModifyFile(fileEvent.GetPath());
+                NoteInteractive(filePath);
                 return true;
             });
 
@@ -189,6 +227,9 @@ namespace AIAssistant
             {
                 LOG_APP_INFO("File removed: {}", fileEvent.GetPath());
                 filePath = m_FileCategorizer.RemoveFile(fileEvent.GetPath());
+                // replies still in flight for it are discarded, see CompleteQuery
+                m_LastWrittenSequence.erase(fileEvent.GetPath());
+                m_Documents.erase(fileEvent.GetPath());
                 return true;
             });
     }
@@ -197,320 +238,790 @@ namespace AIAssistant
 
     bool SessionManager::IsIdle() const { return m_StateMachine.GetState() == StateMachine::State::AllResponsesReceived; }
 
+    bool SessionManager::HasOutstandingWork() const
+    {
+        if ((m_InFlightQueries != 0) || !m_CompletedQueries.empty())
+        {
+            return true;
+        }
+        auto const& requirements = m_FileCategorizer.GetCategorizedFiles().m_Requirements;
+        return m_Environment.GetEnvironmentComplete() && (requirements.GetModifiedFiles() != 0);
+    }
+
     void SessionManager::DispatchQuery(TrackedFile& requirementFile)
     {
-        // R"(...)" introduces a raw string literal in C++
-        // 👉 No escape sequences (\n, \", \\, etc.) are interpreted.
-        // 👉 Everything between the parentheses is taken literally — including newlines, backslashes, and quotes.
-        //
-        // example request data (model: gpt-4.1, content: Hello from C++!), all quotes are part of json format:
-        // {"model": "gpt-4.1","messages": [{"role": "user", "content": "Hello from C++!"}]}
-        // -----------+++++++--------------------------------------------+++++++++++++++----
-        auto makeRequestDataAPI1 = [](std::string const& model, std::string const& message) -> std::string
-        { return R"({"model": ")" + model + R"(","messages": [{"role": "user", "content": ")" + message + R"("}]})"; };
-
-        // example request data (model: gpt-5-nano, content: write a haiku about ai), all quotes are part of json format:
-        //{"model": "gpt-5-nano", "input": "write a haiku about ai", "store": true}
-        // ----------++++++++++-------------++++++++++++++++++++++------------++++-
-        auto makeRequestDataAPI2 = [](std::string const& model, std::string const& message,
-                                      std::string const& store) -> std::string
-        { return R"({"model": ")" + model + R"(", "input": ")" + message + R"(", "store": )" + store + "}"; };
-
-        // retrieve prompt data from queue
-        std::string message = m_Environment.GetEnvironmentAndResetDirtyFlag();
-
-        auto fileContent = requirementFile.GetContent();
-        message += fileContent;
-
-        auto sanitizedMessage = JsonHelper().SanitizeForJson(message);
+        // read first: a file read from disk now is rehashed, GetHash() then matches what is sent
+        std::shared_ptr<std::string const> content = requirementFile.GetContent();
 
-        bool store{false};
-        std::string requestData;
+        size_t const maxChunkSize = Core::g_Core->GetConfig().m_MaxFileSizekB * 1024;
+        if ((content->size() > maxChunkSize) && MarkdownChunker::IsMarkdown(requirementFile.GetPath()))
         {
-            auto apiIndex = Core::g_Core->GetConfig().m_ApiIndex;
-            auto& api = Core::g_Core->GetConfig().m_ApiInterfaces[apiIndex];
-            switch (api.m_InterfaceType)
+            DispatchDocument(requirementFile, *content);
+            return;
+        }
+
+        auto result = std::make_shared<QueryResult>();
+        result->m_Sequence = ++m_DispatchSequence;
+        result->m_InputFilename = requirementFile.GetPath().string();
+        result->m_InputHash = requirementFile.GetHash();
+        result->m_EnvironmentHash = m_Environment.GetHash();
+        PostQuery(result, *content, GetPriority(requirementFile));
+    }
+
+    void SessionManager::DispatchDocument(TrackedFile& requirementFile, std::string const& content)
+    {
+        std::string inputFilename = requirementFile.GetPath().string();
+
+        // the chunks are views into content, each is escaped into its own request body
+        size_t const maxChunkSize = Core::g_Core->GetConfig().m_MaxFileSizekB * 1024;
+        std::vector<std::string_view> chunks = MarkdownChunker::Split(content, maxChunkSize);
+        if (chunks.empty())
+        {
+            LOG_APP_WARN("Nothing to send in '{}'", inputFilename);
+            return;
+        }
+
+        // replaces a dispatch of an older version that is still in flight, its replies are discarded
+        uint64_t sequence = ++m_DispatchSequence;
+        m_Documents[inputFilename] = Document{
+            .m_Sequence = sequence,                                    //
+            .m_InputHash = requirementFile.GetHash(),                  //
+            .m_EnvironmentHash = m_Environment.GetHash(),              //
+            .m_ChunkOutputs = std::vector<std::string>(chunks.size()), //
+            .m_PendingChunks = chunks.size()                           //
+        };
+        LOG_APP_INFO("Sending '{}' in {} chunks", inputFilename, chunks.size());
+
+        bool const writeChunkFiles = Core::g_Core->GetConfig().m_WriteChunkFiles;
+        fs::path chunkFolder = MarkdownChunker::GetChunkFolder(requirementFile.GetPath());
+        for (size_t chunkIndex = 0; chunkIndex < chunks.size(); ++chunkIndex)
+        {
+            if (writeChunkFiles)
             {
-                case ConfigParser::EngineConfig::InterfaceType::API1:
+                FileWriter::Get().Write(chunkFolder / MarkdownChunker::GetChunkFilename(chunkIndex, /*output*/ false),
+                                        std::string(chunks[chunkIndex]));
+            }
+
+            auto result = std::make_shared<QueryResult>();
+            result->m_Sequence = sequence;
+            result->m_InputFilename = inputFilename;
+            result->m_InputHash = requirementFile.GetHash();
+            result->m_EnvironmentHash = m_Environment.GetHash();
+            result->m_ChunkIndex = chunkIndex;
+            result->m_ChunkCount = chunks.size();
+            // cache hits complete through the event queue as well, the last chunk erases the document
+            PostQuery(result, chunks[chunkIndex], ThreadPool::Priority::Bulk);
+        }
+    }
+
+    void SessionManager::PostQuery(std::shared_ptr<QueryResult> const& result, std::string_view content,
+                                   ThreadPool::Priority priority)
+    {
+        std::string const& inputFilename = result->m_InputFilename;
+
+        // environment and requirement are not concatenated: the body references the environment,
+        // escaped once per environment version, and curl reads both from where they are
+        CurlWrapper::QueryData queryData = {
+            .m_Url = m_Url,                                                                                    //
+            .m_Body = m_RequestBuilder->Build(m_Environment.GetEscapedEnvironmentAndResetDirtyFlag(), content) //
+        };
+
+        // the environment enters the cache key as its digest, taken once per environment version
+        result->m_CacheKey = ResponseCache::MakeKey(m_Url, m_Model, m_ApiInterface.m_InterfaceType,
+                                                    m_Environment.GetEscapedDigest(), content);
+
+        result->m_DispatchTime = std::chrono::steady_clock::now();
+
+        // streaming: deltas go to a hidden file next to the output in blocks, CompleteQuery moves it
+        // over the output once the reply is complete and not outdated, so a dropped connection or a
+        // superseded reply never touches the output;
+        // chat files (PROB_xxx) are answered from their output file by the watcher, so their deltas go
+        // to the browser only, batched the same way, and the output file is written once the reply is
+        // complete;
+        // document chunks have no output file
+        struct StreamState
+        {
+            StreamState(ConfigParser::EngineConfig::InterfaceType interfaceType, fs::path const& outputPath,
+                        uint64_t sequence)
+                : m_Reply(interfaceType),
+                  m_StreamPath(outputPath.empty() ? fs::path{} : GetStreamPath(outputPath, sequence))
+            {
+            }
+            // writes the buffered deltas, opens the file with its header on first use;
+            // chat deltas go to the browser instead
+            void WritePending(std::string const& model)
+            {
+                if (m_Pending.empty())
                 {
-                    requestData = makeRequestDataAPI1(m_Model, sanitizedMessage);
-                    break;
+                    return;
                 }
-                case ConfigParser::EngineConfig::InterfaceType::API2:
+                if (m_ChatId.has_value())
                 {
-                    requestData = makeRequestDataAPI2(m_Model, sanitizedMessage, store ? "true" : "false");
-                    break;
+                    App::g_App->GetChatMessagePool()->StreamDelta(m_ChatId.value(), m_Pending);
                 }
-                default:
-                    break; // no more checking here in the run loop
-            };
-        }
+                else
+                {
+                    if (!m_OutputFile)
+                    {
+                        m_OutputFile = FileWriter::Get().OpenWithHeader(m_StreamPath, model);
+                    }
+                    if (m_OutputFile)
+                    {
+                        m_OutputFile->write(m_Pending.data(), m_Pending.size());
+                    }
+                }
+                m_Pending.clear();
+                m_LastWrite = std::chrono::steady_clock::now();
+            }
 
-        CurlWrapper::QueryData queryData = {
-            .m_Url = m_Url,       //
-            .m_Data = requestData //
+            StreamingReply m_Reply;
+            fs::path m_StreamPath; // per dispatch, replies of the same file may overlap
+            std::unique_ptr<std::ofstream> m_OutputFile;
+            std::string m_Pending; // deltas not written yet
+            std::chrono::steady_clock::time_point m_LastWrite{std::chrono::steady_clock::now()};
+            std::optional<uint64_t> m_ChatId;
         };
-
-        auto& threadpool = Core::g_Core->GetThreadPool();
-        std::string inputFilename = requirementFile.GetPath().string();
-        auto query = [this, queryData, inputFilename]() -> bool
+        std::shared_ptr<StreamState> streamState;
+        CurlMulti::DataCallback onData;
+        if (Core::g_Core->GetConfig().m_StreamResponses)
         {
-            try
+            streamState = std::make_shared<StreamState>(Core::g_Core->GetInterfaceType(),
+                                                        result->IsChunk() ? fs::path{} : GetOutputPath(inputFilename),
+                                                        result->m_Sequence);
+            auto probFileInfo = ProbUtils::ParseProbFilename(fs::path(inputFilename).filename().string());
+            if (probFileInfo.has_value() && !probFileInfo.value().isOutput)
             {
-                auto& curl = CurlManager::GetThreadCurl();
-                curl.Clear();
+                streamState->m_ChatId = probFileInfo.value().id;
+            }
 
-                bool ok = curl.Query(queryData);
+            // runs on the curl event loop for every chunk of the body
+            onData = [model = m_Model, streamState](std::string_view chunk)
+            {
+                streamState->m_Reply.Feed(chunk,
+                                          [&](std::string_view delta)
+                                          {
+                                              if (streamState->m_StreamPath.empty() &&
+                                                  !streamState->m_ChatId.has_value())
+                                              {
+                                                  return;
+                                              }
+                                              streamState->m_Pending.append(delta);
+                                              if ((streamState->m_Pending.size() >= STREAM_WRITE_SIZE) ||
+                                                  (std::chrono::steady_clock::now() - streamState->m_LastWrite >=
+                                                   STREAM_WRITE_INTERVAL))
+                                              {
+                                                  streamState->WritePending(model);
+                                              }
+                                          });
+            };
+        }
 
-                // Always create a parser, even if curl failed (empty buffer)
-                auto interfaceType = Core::g_Core->GetInterfaceType();
-                m_ReplyParser = ReplyParser::Create(interfaceType, ok ? curl.GetBuffer() : "");
+        // runs on the thread pool once the curl multi engine has received the full response,
+        // it only fills the result: output files are written by CompleteQueries
+        auto parseResponse = [result, streamState, model = m_Model](CurlMulti::Response& response) -> bool
+        {
+            bool ok = response.m_Ok;
+            result->m_HttpStatus = response.m_HttpStatus;
+            result->m_Latency = std::chrono::steady_clock::now() - result->m_DispatchTime;
 
-                // If curl itself failed → safe exit
-                if (!ok)
+            if (response.m_Streamed)
+            {
+                StreamingReply const& reply = streamState->m_Reply;
+                result->m_Usage = reply.GetUsage();
+                if (ok && !reply.HasError() && reply.IsComplete())
                 {
-                    LOG_APP_ERROR("Curl network error while processing: {}", inputFilename);
-                    return false;
+                    streamState->WritePending(model); // the tail of the reply
+                }
+                bool streamed = (streamState->m_OutputFile != nullptr);
+                if (streamed)
+                {
+                    streamState->m_OutputFile->close();
+                    if (streamState->m_OutputFile->fail())
+                    {
+                        // CompleteQuery writes the output from the content instead
+                        LOG_APP_WARN("Could not write '{}'", streamState->m_StreamPath.string());
+                        std::error_code errorCode;
+                        fs::remove(streamState->m_StreamPath, errorCode);
+                        streamed = false;
+                    }
                 }
+                // the output itself is only touched by a complete reply
+                auto discardStream = [&]()
+                {
+                    if (streamed)
+                    {
+                        std::error_code errorCode;
+                        fs::remove(streamState->m_StreamPath, errorCode);
+                    }
+                };
 
-                // Parser error?
-                if (m_ReplyParser->HasError())
+                if (!ok || reply.HasError() || !reply.IsComplete())
                 {
+                    LOG_APP_ERROR("Streamed reply for '{}' did not complete", result->m_InputFilename);
+                    discardStream();
+                    result->m_Status = reply.HasError() ? QueryResult::Status::ReplyError
+                                                        : QueryResult::Status::Incomplete;
                     return false;
                 }
 
-                size_t hasContent = m_ReplyParser->HasContent();
-                if (hasContent == 0)
+                if (reply.GetContent().empty())
                 {
-                    LOG_APP_WARN("No content returned for '{}'", inputFilename);
+                    discardStream();
+                    result->m_Status = QueryResult::Status::NoContent;
                     return false;
                 }
 
-                // Write all returned content blocks
-                for (size_t index = 0; index < hasContent; ++index)
+                result->m_Content.push_back(reply.GetContent());
+                if (streamed)
                 {
-                    std::string contentText = m_ReplyParser->GetContent(index);
-                    LOG_APP_INFO("message:");
-                    std::cout << contentText << "\n";
+                    result->m_StreamedOutput = streamState->m_StreamPath;
+                }
+                result->m_Status = QueryResult::Status::Ok;
+                ResponseCache::Get().Insert(result->m_CacheKey, result->m_Content);
+                return true;
+            }
 
-                    fs::path outputPath(inputFilename);
-                    outputPath.replace_filename(outputPath.stem().string() + ".output" + outputPath.extension().string());
+            // If curl itself failed → safe exit
+            if (!ok)
+            {
+                result->m_Status = QueryResult::Status::NetworkError;
+                return false;
+            }
 
-                    FileWriter::Get().WriteWithHeader(outputPath, contentText, m_Model);
-                }
+            // the parser takes over the receive buffer, no copy; it lives only as long as this query
+            auto replyParser = ReplyParser::Create(Core::g_Core->GetInterfaceType(), std::move(response.m_Buffer));
+            if (!replyParser)
+            {
+                result->m_Status = QueryResult::Status::ReplyError;
+                return false;
+            }
+            result->m_Usage = replyParser->GetUsage();
 
-                return true;
+            // Parser error?
+            if (replyParser->HasError())
+            {
+                result->m_Status = QueryResult::Status::ReplyError;
+                result->m_ErrorMessage = replyParser->GetErrorMessage();
+                return false;
             }
-            catch (const std::exception& e)
+
+            size_t hasContent = replyParser->HasContent();
+            if (hasContent == 0)
             {
-                LOG_APP_ERROR("Exception in query thread for '{}': {}", inputFilename, e.what());
+                result->m_Status = QueryResult::Status::NoContent;
                 return false;
             }
+
+            for (size_t index = 0; index < hasContent; ++index)
+            {
+                result->m_Content.emplace_back(replyParser->GetContent(index));
+            }
+            result->m_Status = QueryResult::Status::Ok;
+            ResponseCache::Get().Insert(result->m_CacheKey, result->m_Content);
+
+            return true;
+        };
+
+        // usage is accounted on the pool thread as well, failed queries may have consumed tokens too
+        // then the result goes back to this session through the event queue, always: the session
+        // counts its queries in flight and would never become idle without it
+        auto onResponse = [parseResponse, result, apiInterface = m_ApiInterface, sessionCounters = m_SessionCounters,
+                           modelCounters = m_ModelCounters, session = m_NameEntry](CurlMulti::Response& response) -> bool
+        {
+            bool ok{false};
+            try
+            {
+                ok = parseResponse(response);
+            }
+            catch (std::exception const& exception)
+            {
+                // simdjson throws on unexpected types, e.g. "code": null in an error object
+                LOG_APP_ERROR("Failed to parse reply for '{}': {}", result->m_InputFilename, exception.what());
+                result->m_Status = QueryResult::Status::ReplyError;
+                result->m_ErrorMessage = exception.what();
+            }
+            catch (...)
+            {
+                LOG_APP_ERROR("Failed to parse reply for '{}'", result->m_InputFilename);
+                result->m_Status = QueryResult::Status::ReplyError;
+            }
+            result->m_EstimatedCost = UsageMetrics::EstimateCost(result->m_Usage, apiInterface);
+            UsageMetrics::Get().Record(*result, sessionCounters, modelCounters);
+            Core::g_Core->PushEvent(EventPool::Create<QueryCompletedEvent>(session, result, ok));
+            return ok;
         };
 
-        m_QueryFutures.push_back(threadpool.SubmitTask(query));
+        // identical prompt answered before: no network round trip; the entry file is read on the
+        // thread pool and the cached reply completes through the event queue like any other
+        if (ResponseCache::Get().Contains(result->m_CacheKey))
+        {
+            Core::g_Core->GetThreadPool().DetachTask(
+                [queryData = std::move(queryData), onResponse, onData, priority, result,
+                 sessionCounters = m_SessionCounters, modelCounters = m_ModelCounters, session = m_NameEntry]()
+                {
+                    if (auto cached = ResponseCache::Get().Lookup(result->m_CacheKey))
+                    {
+                        result->m_Content = std::move(cached.value());
+                        result->m_Status = QueryResult::Status::Ok;
+                        result->m_FromCache = true;
+                        UsageMetrics::Get().RecordCacheHit(sessionCounters, modelCounters);
+                        Core::g_Core->PushEvent(EventPool::Create<QueryCompletedEvent>(session, result, true));
+                        return;
+                    }
+                    // evicted or unreadable meanwhile, sent after all
+                    Core::g_Core->GetCurlMulti().Post(queryData, onResponse, onData, priority);
+                },
+                priority);
+            ++m_InFlightQueries;
+            return;
+        }
+
+        Core::g_Core->GetCurlMulti().Post(queryData, onResponse, onData, priority);
+        ++m_InFlightQueries;
     }
 
-    void SessionManager::CheckForUpdates()
+    void SessionManager::CompleteQuery(QueryResult const& result)
     {
-        bool environmentUpdate{false};
+        ++m_CompletedQueriesThisRun;
+        std::string const& inputFilename = result.m_InputFilename;
+        if (result.m_FromCache)
+        {
+            LOG_APP_INFO("Response cache hit for '{}'", inputFilename);
+        }
+        else
+        {
+            UsageMetrics::Get().AppendToLog(m_Name, m_Model, result);
+        }
 
-        auto& categorized = m_FileCategorizer.GetCategorizedFiles();
+        if (result.IsChunk())
+        {
+            CompleteChunk(result);
+            return;
+        }
 
-        if (categorized.m_Settings.GetDirty())
+        switch (result.m_Status)
         {
-            AssembleSettings();
-            m_FileCategorizer.GetCategorizedFiles().m_Settings.SetDirty(false);
-            environmentUpdate = true;
+            case QueryResult::Status::Ok:
+                break;
+            case QueryResult::Status::NetworkError:
+            {
+                LOG_APP_ERROR("Curl network error while processing: {}", inputFilename);
+                return;
+            }
+            case QueryResult::Status::NoContent:
+            {
+                LOG_APP_WARN("No content returned for '{}'", inputFilename);
+                return;
+            }
+            default:
+            {
+                LOG_APP_ERROR("Query for '{}' failed (HTTP {}) {}", inputFilename, result.m_HttpStatus,
+                              result.m_ErrorMessage);
+                return;
+            }
         }
 
-        if (categorized.m_Context.GetDirty())
+        // the requirement was removed while this query was in flight: nobody waits for the output,
+        // and writing it would bring back the bookkeeping dropped with the file
+        if (!m_FileCategorizer.GetCategorizedFiles().m_Requirements.Get().contains(inputFilename))
         {
-            AssembleContext();
-            m_FileCategorizer.GetCategorizedFiles().m_Context.SetDirty(false);
-            environmentUpdate = true;
+            LOG_APP_INFO("Discarding reply for removed '{}'", inputFilename);
+            if (!result.m_StreamedOutput.empty())
+            {
+                std::error_code errorCode;
+                fs::remove(result.m_StreamedOutput, errorCode);
+            }
+            return;
         }
 
-        if (categorized.m_Tasks.GetDirty())
+        // a requirement changed again while this query was in flight and the newer answer is already written
+        uint64_t& lastWritten = m_LastWrittenSequence[inputFilename];
+        if (result.m_Sequence < lastWritten)
         {
-            AssembleTask();
-            m_FileCategorizer.GetCategorizedFiles().m_Tasks.SetDirty(false);
-            environmentUpdate = true;
+            LOG_APP_INFO("Discarding outdated reply for '{}'", inputFilename);
+            if (!result.m_StreamedOutput.empty())
+            {
+                std::error_code errorCode;
+                fs::remove(result.m_StreamedOutput, errorCode);
+            }
+            return;
         }
+        lastWritten = result.m_Sequence;
 
-        if (environmentUpdate)
+        // the streamed reply becomes the output in one step
+        bool outputWritten{false};
+        if (!result.m_StreamedOutput.empty())
         {
-            m_Environment.Assemble(m_Settings, m_Context, m_Tasks, categorized);
+            std::error_code errorCode;
+            fs::rename(result.m_StreamedOutput, GetOutputPath(inputFilename), errorCode);
+            if (errorCode)
+            {
+                // written from the content below instead
+                LOG_APP_ERROR("Could not move streamed reply for '{}': {}", inputFilename, errorCode.message());
+                fs::remove(result.m_StreamedOutput, errorCode);
+            }
+            else
+            {
+                outputWritten = true;
+            }
+        }
 
-            // Mark all requirements as modified since their environment changed
-            auto& requirements = m_FileCategorizer.GetCategorizedFiles().m_Requirements;
-            for (auto& element : requirements.m_Map)
+        if (!result.m_FromCache)
+        {
+            LOG_APP_INFO("Reply for '{}' after {} ms, {} input ({} cached) / {} output tokens, ${:.6f}",
+                         inputFilename, std::chrono::duration_cast<std::chrono::milliseconds>(result.m_Latency).count(),
+                         result.m_Usage.m_InputTokens, result.m_Usage.m_CachedTokens, result.m_Usage.m_OutputTokens,
+                         result.m_EstimatedCost);
+        }
+        for (auto const& contentText : result.m_Content)
+        {
+            if (!result.m_FromCache)
             {
-                if (!element.second->IsModified())
-                {
-                    element.second->MarkModified();
-                    requirements.IncrementModifiedFiles();
-                }
+                LOG_APP_INFO("message:");
+                std::cout << contentText << "\n";
             }
 
-            LOG_APP_INFO("Environment updated → all requirements marked for dependency recheck");
+            if (outputWritten)
+            {
+                FileHashIndex::Get().RecordOutput(result.m_InputHash, result.m_EnvironmentHash,
+                                                  GetOutputPath(inputFilename));
+            }
+            else
+            {
+                WriteOutput(inputFilename, contentText, result.m_InputHash, result.m_EnvironmentHash);
+            }
         }
     }
 
-    void SessionManager::TrackInFlightQueries()
+    void SessionManager::CompleteChunk(QueryResult const& result)
     {
-        // --- clean up futures and report result ---
-        m_QueryFutures.erase(           //
-            std::remove_if(             //
-                m_QueryFutures.begin(), //
-                m_QueryFutures.end(),   //
-                [&](auto& future)
-                {
-                    if (future.wait_for(std::chrono::seconds(0s)) == std::future_status::ready)
-                    {
-                        bool curleOk = future.get();
-                        ++m_CompletedQueriesThisRun;
-                        // report bad curl to engine
-                        if (!curleOk)
-                        {
-                            auto appErrorEvent = std::make_shared<AppErrorEvent>(AppErrorEvent::AppErrorBadCurl);
-                            Core::g_Core->PushEvent(appErrorEvent);
-                        }
-                        return true; // remove from list
-                    }
-                    return false; // keep in list, we'll check next frame again
-                }),
-            m_QueryFutures.end());
-    }
+        std::string const& inputFilename = result.m_InputFilename;
+        size_t chunkNumber = result.m_ChunkIndex + 1;
 
-    void SessionManager::AssembleSettings()
-    {
-        auto& settings = m_FileCategorizer.GetCategorizedFiles().m_Settings;
-        if (settings.GetModifiedFiles() == 0)
+        auto iterator = m_Documents.find(inputFilename);
+        if ((iterator == m_Documents.end()) || (iterator->second.m_Sequence != result.m_Sequence))
+        {
+            LOG_APP_INFO("Discarding outdated reply for chunk {} of '{}'", chunkNumber, inputFilename);
+            return;
+        }
+        Document& document = iterator->second;
+        --document.m_PendingChunks;
+
+        if (result.IsOk())
+        {
+            std::string& chunkOutput = document.m_ChunkOutputs[result.m_ChunkIndex];
+            for (auto const& contentText : result.m_Content)
+            {
+                chunkOutput += contentText;
+            }
+            if (Core::g_Core->GetConfig().m_WriteChunkFiles)
+            {
+                fs::path chunkOutputPath = MarkdownChunker::GetChunkFolder(inputFilename) /
+                                           MarkdownChunker::GetChunkFilename(result.m_ChunkIndex, /*output*/ true);
+                FileWriter::Get().WriteWithHeader(chunkOutputPath, chunkOutput, m_Model);
+            }
+        }
+        else
+        {
+            LOG_APP_ERROR("Chunk {} of {} of '{}' failed (HTTP {}) {}", chunkNumber, result.m_ChunkCount, inputFilename,
+                          result.m_HttpStatus, result.m_ErrorMessage);
+            ++document.m_FailedChunks;
+        }
+
+        if (document.m_PendingChunks != 0)
         {
             return;
         }
 
-        auto& map = settings.m_Map;
-        m_Settings.clear();
-        for (auto& element : map)
+        if (document.m_FailedChunks != 0)
+        {
+            // no partial output, the document is sent again when it or its environment changes
+            LOG_APP_ERROR("Output for '{}' not written, {} of {} chunks failed", inputFilename,
+                          document.m_FailedChunks, document.m_ChunkOutputs.size());
+        }
+        else if (document.m_Sequence >= m_LastWrittenSequence[inputFilename])
         {
-            bool isModified = element.second->IsModified();
-            element.second->MarkModified(false);
-            auto content = element.second->GetContent();
-            m_Settings += content;
-            if (isModified)
+            // reduce: the replies in chunk order, each followed by one blank line
+            std::string output;
+            for (auto const& chunkOutput : document.m_ChunkOutputs)
             {
-                settings.DecrementModifiedFiles();
+                size_t end = chunkOutput.find_last_not_of(" \t\n\r\f\v");
+                output.append(chunkOutput, 0, (end == std::string::npos) ? 0 : end + 1);
+                output += "\n\n";
             }
+            LOG_APP_INFO("Joined {} chunk replies for '{}'", document.m_ChunkOutputs.size(), inputFilename);
+
+            m_LastWrittenSequence[inputFilename] = document.m_Sequence;
+            WriteOutput(inputFilename, output, document.m_InputHash, document.m_EnvironmentHash);
         }
+        m_Documents.erase(iterator);
     }
 
-    void SessionManager::AssembleContext()
+    void SessionManager::WriteOutput(std::string const& inputFilename, std::string const& contentText,
+                                     EngineCore::Digest const& inputHash, EngineCore::Digest const& environmentHash)
     {
-        auto& context = m_FileCategorizer.GetCategorizedFiles().m_Context;
-        if (context.GetModifiedFiles() == 0)
+        fs::path outputPath = GetOutputPath(inputFilename);
+
+        FileWriter::Get().WriteWithHeader(outputPath, contentText, m_Model);
+        FileHashIndex::Get().RecordOutput(inputHash, environmentHash, outputPath);
+    }
+
+    fs::path SessionManager::GetOutputPath(std::string const& inputFilename)
+    {
+        fs::path outputPath(inputFilename);
+        outputPath.replace_filename(outputPath.stem().string() + ".output" + outputPath.extension().string());
+        return outputPath;
+    }
+
+    fs::path SessionManager::GetStreamPath(fs::path const& outputPath, uint64_t sequence)
+    {
+        // hidden: the file watcher ignores it
+        fs::path streamPath(outputPath);
+        streamPath.replace_filename("." + outputPath.filename().string() + "." + std::to_string(sequence) + ".partial");
+        return streamPath;
+    }
+
+    bool SessionManager::DispatchInteractiveRequirements()
+    {
+        if (m_PendingInteractive.empty())
         {
-            return;
+            return false;
         }
 
-        auto& map = context.m_Map;
-        m_Context.clear();
-        for (auto& element : map)
+        auto& requirements = m_FileCategorizer.GetCategorizedFiles().m_Requirements;
+        bool anyQueryDispatched = false;
+        for (auto const& path : m_PendingInteractive)
         {
-            bool isModified = element.second->IsModified();
-            element.second->MarkModified(false);
-            auto content = element.second->GetContent();
-            m_Context += content;
-            if (isModified)
+            auto element = requirements.Get().find(path);
+            // not a requirement, removed, or sent by DispatchRequirements() already
+            if ((element == requirements.Get().end()) || !element->second->IsModified())
             {
-                context.DecrementModifiedFiles();
+                continue;
             }
+            anyQueryDispatched |= DispatchRequirement(*element->second, requirements);
         }
+        m_PendingInteractive.clear();
+        return anyQueryDispatched;
     }
 
-    void SessionManager::AssembleTask()
+    bool SessionManager::DispatchRequirements()
     {
-        auto& tasks = m_FileCategorizer.GetCategorizedFiles().m_Tasks;
-        if (tasks.GetModifiedFiles() == 0)
+        auto& requirements = m_FileCategorizer.GetCategorizedFiles().m_Requirements;
+        if (requirements.GetModifiedFiles() == 0)
         {
-            return;
+            return false;
         }
 
-        auto& map = tasks.m_Map;
-        m_Tasks.clear();
-        for (auto& element : map)
+        bool anyQueryDispatched = false;
+        for (auto& element : requirements.Get())
         {
-            bool isModified = element.second->IsModified();
-            element.second->MarkModified(false);
-            auto content = element.second->GetContent();
-            m_Tasks += content;
-            if (isModified)
+            if (element.second->IsModified())
             {
-                tasks.DecrementModifiedFiles();
+                anyQueryDispatched |= DispatchRequirement(*element.second, requirements);
             }
         }
+        return anyQueryDispatched;
     }
 
-    void SessionManager::Environment::Assemble(std::string& settings, std::string& context, std::string& tasks,
-                                               CategorizedFiles& categorized)
+    bool SessionManager::DispatchRequirement(TrackedFile& requirementFile, TrackedFiles& requirements)
     {
-        SetEnvironmentComplete(false);
+        bool queryRequired = IsQueryRequired(requirementFile);
+        if (queryRequired)
+        {
+            DispatchQuery(requirementFile);
+        }
+        requirementFile.MarkModified(false);
+        requirementFile.ReleaseContent(); // requirements are sent once, don't keep them in memory
+        requirements.DecrementModifiedFiles();
+        return queryRequired;
+    }
 
-        if (settings.empty() || context.empty() || tasks.empty())
+    void SessionManager::NoteInteractive(fs::path const& requirementPath)
+    {
+        if (!requirementPath.empty() && ProbUtils::IsProbFile(requirementPath.filename().string()))
         {
-            m_Timestamp = fs::file_time_type::min();
-            m_Dirty = false;
-            return;
+            m_PendingInteractive.insert(requirementPath.string());
         }
+    }
 
-        // Combine environment parts
-        std::string environmentCombined = settings + context + tasks;
+    ThreadPool::Priority SessionManager::GetPriority(TrackedFile const& requirementFile)
+    {
+        std::string filename = requirementFile.GetPath().filename().string();
 
-        // Compare with previous
-        if (environmentCombined != m_EnvironmentCombined)
+        // a user in the web chat is waiting for PROB_xxx files
+        if (ProbUtils::IsProbFile(filename))
         {
-            m_EnvironmentCombined = std::move(environmentCombined);
-            m_Timestamp = ComputeTimestamp(categorized);
-            m_Dirty = true;
+            return ThreadPool::Priority::Interactive;
         }
-        else
+        return ThreadPool::Priority::Normal;
+    }
+
+    void SessionManager::CheckForUpdates()
+    {
+        bool environmentUpdate{false};
+
+        auto& categorized = m_FileCategorizer.GetCategorizedFiles();
+        auto updatePart = [&](Environment::Part part, TrackedFiles& files)
         {
-            m_Dirty = false;
+            if (files.GetDirty())
+            {
+                environmentUpdate |= m_Environment.Update(part, files);
+                files.SetDirty(false);
+            }
+        };
+        updatePart(Environment::Settings, categorized.m_Settings);
+        updatePart(Environment::Context, categorized.m_Context);
+        updatePart(Environment::Tasks, categorized.m_Tasks);
+
+        if (!environmentUpdate)
+        {
+            return;
         }
 
-        SetEnvironmentComplete(true);
+        m_Environment.Assemble();
+        if (m_Environment.GetDirty())
+        {
+            // Mark all requirements as modified since their environment changed
+            auto& requirements = categorized.m_Requirements;
+            for (auto& element : requirements.m_Map)
+            {
+                if (!element.second->IsModified())
+                {
+                    element.second->MarkModified();
+                    requirements.IncrementModifiedFiles();
+                }
+                NoteInteractive(element.second->GetPath());
+            }
+
+            LOG_APP_INFO("Environment updated → all requirements marked for dependency recheck");
+        }
+    }
+
+    void SessionManager::CompleteQueries()
+    {
+        if (m_CompletedQueries.empty())
+        {
+            return;
+        }
+
+        // --- ordered completion stage: outputs are written in dispatch order ---
+        std::sort(m_CompletedQueries.begin(), m_CompletedQueries.end(),
+                  [](auto const& left, auto const& right) { return left->m_Sequence < right->m_Sequence; });
+        for (auto const& result : m_CompletedQueries)
+        {
+            CompleteQuery(*result);
+        }
+        m_CompletedQueries.clear();
     }
 
-    fs::file_time_type SessionManager::Environment::ComputeTimestamp(CategorizedFiles& categorized) const
+    bool SessionManager::Environment::Update(Part part, TrackedFiles& files)
     {
-        std::vector<fs::path> envFiles;
+        bool changed{false};
+        FileSegments& segments = m_Parts[part];
+        auto& map = files.Get();
 
-        envFiles.reserve(categorized.m_Settings.m_Map.size() + categorized.m_Context.m_Map.size() +
-                         categorized.m_Tasks.m_Map.size());
+        // removed files
+        for (auto iterator = segments.begin(); iterator != segments.end();)
+        {
+            if (!map.contains(iterator->first))
+            {
+                iterator = segments.erase(iterator);
+                changed = true;
+            }
+            else
+            {
+                ++iterator;
+            }
+        }
 
-        for (auto const& keyValue : categorized.m_Settings.m_Map)
+        // new and modified files, the others are not touched
+        for (auto& [path, trackedFile] : map)
         {
-            envFiles.push_back(keyValue.second->GetPath());
+            auto iterator = segments.find(path);
+            if (!trackedFile->IsModified() && (iterator != segments.end()))
+            {
+                continue;
+            }
+            if (trackedFile->IsModified())
+            {
+                trackedFile->MarkModified(false);
+                files.DecrementModifiedFiles();
+            }
+
+            EngineCore::Digest hash = trackedFile->GetHash();
+            if ((iterator != segments.end()) && (iterator->second.m_Hash == hash))
+            {
+                continue; // written, but the same content
+            }
+
+            // the hash is taken again after reading, it belongs to the bytes that are escaped
+            std::shared_ptr<std::string const> content = trackedFile->GetContent();
+            FileSegment& segment = segments[path];
+            segment.m_Hash = trackedFile->GetHash();
+            segment.m_EscapedContent = std::make_shared<std::string const>(JsonHelper().SanitizeForJson(*content));
+            segment.m_LastWriteTime = trackedFile->GetFileStat().m_LastWriteTime;
+            trackedFile->ReleaseContent(); // the segment keeps the escaped copy
+            changed = true;
         }
+        return changed;
+    }
+
+    void SessionManager::Environment::Assemble()
+    {
+        SetEnvironmentComplete(false);
 
-        for (auto const& keyValue : categorized.m_Context.m_Map)
+        // every part needs some content
+        for (auto const& segments : m_Parts)
         {
-            envFiles.push_back(keyValue.second->GetPath());
+            bool empty = std::all_of(segments.begin(), segments.end(),
+                                     [](auto const& element) { return element.second.m_EscapedContent->empty(); });
+            if (empty)
+            {
+                m_LastWriteTime = 0;
+                m_Hash = {};
+                m_EscapedDigest = {};
+                m_EscapedEnvironment.clear();
+                m_Dirty = false;
+                return;
+            }
         }
 
-        for (auto const& keyValue : categorized.m_Tasks.m_Map)
+        // the hash of the segment hashes identifies the environment, no need to look at the content
+        EngineCore::Hasher hasher(EngineCore::GetHashAlgorithm());
+        m_EscapedEnvironment.clear();
+        m_LastWriteTime = 0;
+        for (auto const& segments : m_Parts)
         {
-            envFiles.push_back(keyValue.second->GetPath());
+            for (auto const& [path, segment] : segments)
+            {
+                hasher.Update(segment.m_Hash.m_Bytes.data(), segment.m_Hash.m_Size);
+                m_EscapedEnvironment.push_back(segment.m_EscapedContent);
+                m_LastWriteTime = std::max(m_LastWriteTime, segment.m_LastWriteTime);
+            }
         }
 
-        return EngineCore::GetNewestTimestamp(envFiles);
+        EngineCore::Digest hash = hasher.Finalize();
+        if (hash != m_Hash)
+        {
+            m_Hash = hash;
+            m_Dirty = true;
+
+            // the escaped bytes are hashed here, once, and not by every query of this version
+            EngineCore::Hasher escapedHasher(EngineCore::HashAlgorithm::Sha256);
+            for (auto const& segment : m_EscapedEnvironment)
+            {
+                escapedHasher.Update(segment->data(), segment->size());
+            }
+            m_EscapedDigest = escapedHasher.Finalize();
+        }
+
+        SetEnvironmentComplete(true);
     }
 
-    std::string& SessionManager::Environment::GetEnvironmentAndResetDirtyFlag()
+    std::vector<RequestBody::Segment> const& SessionManager::Environment::GetEscapedEnvironmentAndResetDirtyFlag()
     {
         m_Dirty = false;
-        return m_EnvironmentCombined;
+        return m_EscapedEnvironment;
     }
 
     void SessionManager::Environment::SetDirty(bool dirty) { m_Dirty = dirty; }
@@ -20,14 +20,20 @@
    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 #pragma once
-#include <future>
 #include <array>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "engine.h"
-#include "curlWrapper/curlManager.h"
+#include "curlWrapper/curlMulti.h"
+#include "event/pathTable.h"
 #include "file/trackedFile.h"
 #include "file/fileCategorizer.h"
 #include "json/replyParser.h"
+#include "json/requestBuilder.h"
+#include "session/queryResult.h"
+#include "session/usageMetrics.h"
 #include "jarvisAgent.h"
 
 namespace AIAssistant
@@ -78,63 +84,130 @@ namespace AIAssistant
         void OnEvent(Event&);
         void OnShutdown();
 
-        bool IsIdle() const;
+        bool IsIdle() const; // state machine settled, for status display
+        // queries in flight or ready to be sent; waiting for environment files is not work
+        bool HasOutstandingWork() const;
 
     public:
         std::string const& GetName() const { return m_Name; }
 
     private:
+        // return true if a query was sent
+        bool DispatchInteractiveRequirements(); // modified chat files only, from m_PendingInteractive
+        bool DispatchRequirements();
+        bool DispatchRequirement(TrackedFile& requirementFile, TrackedFiles& requirements);
         void DispatchQuery(TrackedFile& requirementFile);
+        void DispatchDocument(TrackedFile& requirementFile, std::string const& content);
+        // the result carries everything set at dispatch
+        void PostQuery(std::shared_ptr<QueryResult> const& result, std::string_view content,
+                       ThreadPool::Priority priority);
+        void CompleteQuery(QueryResult const& result);
+        void CompleteChunk(QueryResult const& result);
+        void WriteOutput(std::string const& inputFilename, std::string const& contentText,
+                         EngineCore::Digest const& inputHash, EngineCore::Digest const& environmentHash);
+        static fs::path GetOutputPath(std::string const& inputFilename);
+        static fs::path GetStreamPath(fs::path const& outputPath, uint64_t sequence); // streamed reply, until complete
+        static ThreadPool::Priority GetPriority(TrackedFile const& requirementFile);
+        void NoteInteractive(fs::path const& requirementPath);
         void CheckForUpdates();
-        void TrackInFlightQueries();
-        void AssembleSettings();
-        void AssembleContext();
-        void AssembleTask();
+        void CompleteQueries();
         bool IsQueryRequired(TrackedFile& requirementFile) const;
 
     private:
+        // settings, context and tasks (STNG, CNTX, TASK files), one segment per file:
+        // a change re-reads and re-escapes only the files that changed, the hash combines the
+        // segment hashes, and request bodies reference the segments, nothing is concatenated
         class Environment
         {
+        public:
+            enum Part
+            {
+                Settings = 0,
+                Context,
+                Tasks,
+                NumParts
+            };
+
         public:
             bool GetDirty() const { return m_Dirty; };
             bool GetEnvironmentComplete() const { return m_EnvironmentComplete; };
-            void Assemble(std::string& settings, std::string& context, std::string& tasks, CategorizedFiles&);
-            std::string& GetEnvironmentAndResetDirtyFlag();
+            // takes over modified files and drops removed ones, returns true if a segment changed
+            bool Update(Part part, TrackedFiles& files);
+            void Assemble();
+            std::vector<RequestBody::Segment> const& GetEscapedEnvironmentAndResetDirtyFlag();
 
         public:
-            fs::file_time_type GetTimestamp() const { return m_Timestamp; }
+            int64_t GetLastWriteTime() const { return m_LastWriteTime; } // newest file, in ns as EngineCore::FileStat
+            EngineCore::Digest const& GetHash() const { return m_Hash; }
+            // SHA-256 of the escaped environment, for response cache keys
+            EngineCore::Digest const& GetEscapedDigest() const { return m_EscapedDigest; }
             void SetDirty(bool dirty = true);
             void SetEnvironmentComplete(bool complete = true);
 
         private:
-            fs::file_time_type ComputeTimestamp(CategorizedFiles& categorized) const;
-            fs::file_time_type m_Timestamp{};
+            struct FileSegment
+            {
+                EngineCore::Digest m_Hash; // of the file content
+                RequestBody::Segment m_EscapedContent;
+                int64_t m_LastWriteTime{0};
+            };
+            // by path, so the environment is assembled in the same order every time
+            using FileSegments = std::map<std::string, FileSegment>;
 
         private:
-            std::string m_EnvironmentCombined;
+            std::array<FileSegments, NumParts> m_Parts;
+            std::vector<RequestBody::Segment> m_EscapedEnvironment; // all parts, in order
+            EngineCore::Digest m_Hash;
+            EngineCore::Digest m_EscapedDigest; // taken once per environment version
+            int64_t m_LastWriteTime{0};
             bool m_EnvironmentComplete{false};
             bool m_Dirty{true};
         };
 
     private:
         std::string m_Name; // session name = folder name
+        PathTable::Entry m_NameEntry; // interned m_Name, carried by QueryCompletedEvent
         StateMachine m_StateMachine;
 
         FileCategorizer m_FileCategorizer;
 
-        // Environment content
         Environment m_Environment;
-        std::string m_Settings;
-        std::string m_Context;
-        std::string m_Tasks;
 
-        // handles to queries
-        std::vector<std::future<bool>> m_QueryFutures;
+        // queries report back with a QueryCompletedEvent, nothing is polled
+        size_t m_InFlightQueries{0};
+        std::vector<std::shared_ptr<QueryResult>> m_CompletedQueries; // received this frame, written in OnUpdate
+        uint64_t m_DispatchSequence{0};
+        // modified PROB_xxx files, so chat questions are found without walking all requirements
+        std::unordered_set<std::string> m_PendingInteractive;
+        std::unordered_map<std::string, uint64_t> m_LastWrittenSequence; // per requirement file, until removed
+
+        // Markdown documents larger than the max file size: one query per chunk, the replies are
+        // joined in chunk order into the document's output once all of them have arrived
+        struct Document
+        {
+            uint64_t m_Sequence{0}; // shared by all chunks of one dispatch
+            EngineCore::Digest m_InputHash;
+            EngineCore::Digest m_EnvironmentHash;
+            std::vector<std::string> m_ChunkOutputs; // by chunk index
+            size_t m_PendingChunks{0};
+            size_t m_FailedChunks{0};
+        };
+        std::unordered_map<std::string, Document> m_Documents; // by requirement file, latest dispatch only
 
         std::string m_Url;
         std::string m_Model;
+        ConfigParser::EngineConfig::ApiInterface m_ApiInterface;
 
-        std::unique_ptr<ReplyParser> m_ReplyParser;
+        // owned by UsageMetrics
+        UsageMetrics::Counters* m_SessionCounters{nullptr};
+        UsageMetrics::Counters* m_ModelCounters{nullptr};
+
+        std::unique_ptr<RequestBuilder> m_RequestBuilder;
         size_t m_CompletedQueriesThisRun{0};
+
+        // streamed deltas are written in blocks: the curl event loop drives every transfer and must
+        // not wait for the disk once per token
+        static constexpr size_t STREAM_WRITE_SIZE = 64 * 1024;
+        static constexpr std::chrono::milliseconds STREAM_WRITE_INTERVAL{500};
     };
 } // namespace AIAssistant
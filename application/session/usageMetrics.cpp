@@ -0,0 +1,272 @@
+/* Copyright (c) 2025 JC Technolabs
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+#include <algorithm>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+
+#include "engine.h"
+#include "json/jsonHelper.h"
+#include "session/usageMetrics.h"
+
+namespace AIAssistant
+{
+    static char const* GetStatusName(QueryResult::Status status)
+    {
+        switch (status)
+        {
+            case QueryResult::Status::Ok:
+                return "ok";
+            case QueryResult::Status::NetworkError:
+                return "network error";
+            case QueryResult::Status::ReplyError:
+                return "reply error";
+            case QueryResult::Status::NoContent:
+                return "no content";
+            case QueryResult::Status::Incomplete:
+                return "incomplete";
+            default:
+                return "pending";
+        }
+    }
+
+    double UsageMetrics::Totals::GetAverageLatencyMilliseconds() const
+    {
+        uint64_t answered = m_Queries - m_CacheHits;
+        return answered ? static_cast<double>(m_LatencyMicroseconds) / 1e3 / static_cast<double>(answered) : 0.0;
+    }
+
+    double UsageMetrics::Totals::GetCachedTokenRate() const
+    {
+        return m_InputTokens ? static_cast<double>(m_CachedTokens) / static_cast<double>(m_InputTokens) : 0.0;
+    }
+
+    UsageMetrics& UsageMetrics::Get()
+    {
+        static UsageMetrics instance;
+        return instance;
+    }
+
+    void UsageMetrics::Load(fs::path const& logFilepath, size_t maxBytes)
+    {
+        m_LogFilepath = logFilepath;
+        m_MaxLogBytes = maxBytes;
+        m_LogFile.close();
+        m_LogBytes = 0;
+
+        if (m_MaxLogBytes == 0)
+        {
+            LOG_APP_INFO("UsageMetrics: usage log disabled");
+            return;
+        }
+
+        std::error_code errorCode;
+        fs::create_directories(m_LogFilepath.parent_path(), errorCode);
+        auto size = fs::file_size(m_LogFilepath, errorCode);
+        m_LogBytes = errorCode ? 0 : static_cast<size_t>(size);
+
+        m_LogFile.open(m_LogFilepath, std::ios::app);
+        if (!m_LogFile)
+        {
+            LOG_APP_ERROR("UsageMetrics: cannot open usage log '{}'", m_LogFilepath.string());
+            return;
+        }
+        LOG_APP_INFO("UsageMetrics: appending to '{}' ({} kB)", m_LogFilepath.string(), m_LogBytes / 1024);
+    }
+
+    UsageMetrics::Counters* UsageMetrics::GetSessionCounters(std::string const& session)
+    {
+        std::lock_guard lock(m_Mutex);
+        auto& counters = m_Sessions[session];
+        if (!counters)
+        {
+            counters = std::make_unique<Counters>();
+        }
+        return counters.get();
+    }
+
+    UsageMetrics::Counters* UsageMetrics::GetModelCounters(std::string const& model)
+    {
+        std::lock_guard lock(m_Mutex);
+        auto& counters = m_Models[model];
+        if (!counters)
+        {
+            counters = std::make_unique<Counters>();
+        }
+        return counters.get();
+    }
+
+    double UsageMetrics::EstimateCost(ReplyParser::Usage const& usage,
+                                      ConfigParser::EngineConfig::ApiInterface const& apiInterface)
+    {
+        // cached tokens are a discounted part of the input tokens
+        uint64_t cachedTokens = std::min(usage.m_CachedTokens, usage.m_InputTokens);
+        uint64_t uncachedTokens = usage.m_InputTokens - cachedTokens;
+
+        double cost = static_cast<double>(uncachedTokens) * apiInterface.m_InputPrice +
+                      static_cast<double>(cachedTokens) * apiInterface.m_CachedInputPrice +
+                      static_cast<double>(usage.m_OutputTokens) * apiInterface.m_OutputPrice;
+        return cost / 1e6;
+    }
+
+    void UsageMetrics::Record(QueryResult const& result, Counters* sessionCounters, Counters* modelCounters)
+    {
+        uint64_t latency =
+            static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(result.m_Latency).count());
+        uint64_t cost = static_cast<uint64_t>(result.m_EstimatedCost * 1e6 + 0.5);
+
+        for (Counters* counters : {&m_Total, sessionCounters, modelCounters})
+        {
+            if (!counters)
+            {
+                continue;
+            }
+            // totals only, no ordering with other memory is needed
+            counters->m_Queries.fetch_add(1, std::memory_order_relaxed);
+            if (!result.IsOk())
+            {
+                counters->m_FailedQueries.fetch_add(1, std::memory_order_relaxed);
+            }
+            counters->m_InputTokens.fetch_add(result.m_Usage.m_InputTokens, std::memory_order_relaxed);
+            counters->m_CachedTokens.fetch_add(result.m_Usage.m_CachedTokens, std::memory_order_relaxed);
+            counters->m_OutputTokens.fetch_add(result.m_Usage.m_OutputTokens, std::memory_order_relaxed);
+            counters->m_LatencyMicroseconds.fetch_add(latency, std::memory_order_relaxed);
+            counters->m_CostMicroDollars.fetch_add(cost, std::memory_order_relaxed);
+        }
+    }
+
+    void UsageMetrics::RecordCacheHit(Counters* sessionCounters, Counters* modelCounters)
+    {
+        for (Counters* counters : {&m_Total, sessionCounters, modelCounters})
+        {
+            if (counters)
+            {
+                counters->m_Queries.fetch_add(1, std::memory_order_relaxed);
+                counters->m_CacheHits.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void UsageMetrics::AppendToLog(std::string_view session, std::string_view model, QueryResult const& result)
+    {
+        if (!m_LogFile.is_open())
+        {
+            return;
+        }
+
+        std::time_t time = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+
+        JsonHelper jsonHelper;
+        std::string line = R"({"session": ")";
+        jsonHelper.AppendSanitizedForJson(line, session);
+        line += R"(", "model": ")";
+        jsonHelper.AppendSanitizedForJson(line, model);
+        line += R"(", "file": ")";
+        jsonHelper.AppendSanitizedForJson(line, result.m_InputFilename);
+
+        std::ostringstream fields;
+        fields << R"(", "time": ")" << std::put_time(std::localtime(&time), "%Y-%m-%dT%H:%M:%S")         //
+               << R"(", "status": ")" << GetStatusName(result.m_Status)                                  //
+               << R"(", "http status": )" << result.m_HttpStatus                                         //
+               << R"(, "input tokens": )" << result.m_Usage.m_InputTokens                                //
+               << R"(, "cached tokens": )" << result.m_Usage.m_CachedTokens                              //
+               << R"(, "output tokens": )" << result.m_Usage.m_OutputTokens                              //
+               << R"(, "latency ms": )"                                                                   //
+               << std::chrono::duration_cast<std::chrono::milliseconds>(result.m_Latency).count()        //
+               << R"(, "cost": )" << std::fixed << std::setprecision(6) << result.m_EstimatedCost << "}\n"; //
+        line += fields.str();
+
+        if ((m_LogBytes > 0) && (m_LogBytes + line.size() > m_MaxLogBytes))
+        {
+            Rotate();
+        }
+
+        m_LogFile.write(line.data(), static_cast<std::streamsize>(line.size()));
+        m_LogFile.flush();
+        m_LogBytes += line.size();
+    }
+
+    fs::path UsageMetrics::GetRotatedFilepath(size_t index) const
+    {
+        fs::path filepath = m_LogFilepath;
+        filepath.replace_filename(m_LogFilepath.stem().string() + "." + std::to_string(index) +
+                                  m_LogFilepath.extension().string());
+        return filepath;
+    }
+
+    void UsageMetrics::Rotate()
+    {
+        m_LogFile.close();
+
+        // usage.jsonl -> usage.1.jsonl -> ... the oldest one is dropped
+        std::error_code errorCode;
+        fs::remove(GetRotatedFilepath(NUM_ROTATED_LOGS), errorCode);
+        for (size_t index = NUM_ROTATED_LOGS; index > 1; --index)
+        {
+            fs::rename(GetRotatedFilepath(index - 1), GetRotatedFilepath(index), errorCode);
+        }
+        fs::rename(m_LogFilepath, GetRotatedFilepath(1), errorCode);
+
+        m_LogFile.open(m_LogFilepath, std::ios::trunc);
+        m_LogBytes = 0;
+        if (!m_LogFile)
+        {
+            LOG_APP_ERROR("UsageMetrics: cannot reopen usage log '{}'", m_LogFilepath.string());
+        }
+    }
+
+    UsageMetrics::Totals UsageMetrics::Read(Counters const& counters)
+    {
+        Totals totals;
+        totals.m_Queries = counters.m_Queries.load(std::memory_order_relaxed);
+        totals.m_FailedQueries = counters.m_FailedQueries.load(std::memory_order_relaxed);
+        totals.m_CacheHits = counters.m_CacheHits.load(std::memory_order_relaxed);
+        totals.m_InputTokens = counters.m_InputTokens.load(std::memory_order_relaxed);
+        totals.m_CachedTokens = counters.m_CachedTokens.load(std::memory_order_relaxed);
+        totals.m_OutputTokens = counters.m_OutputTokens.load(std::memory_order_relaxed);
+        totals.m_LatencyMicroseconds = counters.m_LatencyMicroseconds.load(std::memory_order_relaxed);
+        totals.m_CostMicroDollars = counters.m_CostMicroDollars.load(std::memory_order_relaxed);
+        return totals;
+    }
+
+    UsageMetrics::Snapshot UsageMetrics::GetSnapshot() const
+    {
+        Snapshot snapshot;
+        snapshot.m_Total = Read(m_Total);
+        {
+            std::lock_guard lock(m_Mutex);
+            for (auto const& [name, counters] : m_Sessions)
+            {
+                snapshot.m_Sessions.emplace_back(name, Read(*counters));
+            }
+            for (auto const& [name, counters] : m_Models)
+            {
+                snapshot.m_Models.emplace_back(name, Read(*counters));
+            }
+        }
+
+        auto byName = [](auto const& left, auto const& right) { return left.first < right.first; };
+        std::sort(snapshot.m_Sessions.begin(), snapshot.m_Sessions.end(), byName);
+        std::sort(snapshot.m_Models.begin(), snapshot.m_Models.end(), byName);
+        return snapshot;
+    }
+} // namespace AIAssistant
@@ -0,0 +1,136 @@
+/* Copyright (c) 2025 JC Technolabs
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "json/configParser.h"
+#include "session/queryResult.h"
+
+namespace fs = std::filesystem;
+
+namespace AIAssistant
+{
+    // Token usage, latency and estimated cost of the queries sent to the API,
+    // aggregated per session, per model and in total.
+    // Counter blocks are registered once (under a mutex) and never move, the
+    // thread pool adds to them with relaxed atomics when a reply has been parsed.
+    // Every completed query is also appended as one JSON line to a rolling log
+    // in the state folder of the queue (usage.jsonl, usage.1.jsonl, ...).
+    class UsageMetrics
+    {
+    public:
+        struct Counters
+        {
+            std::atomic<uint64_t> m_Queries{0};
+            std::atomic<uint64_t> m_FailedQueries{0};
+            std::atomic<uint64_t> m_CacheHits{0}; // answered by the response cache, no tokens spent
+            std::atomic<uint64_t> m_InputTokens{0};
+            std::atomic<uint64_t> m_CachedTokens{0}; // part of m_InputTokens
+            std::atomic<uint64_t> m_OutputTokens{0};
+            std::atomic<uint64_t> m_LatencyMicroseconds{0};
+            std::atomic<uint64_t> m_CostMicroDollars{0};
+        };
+
+        // plain copy of a counter block
+        struct Totals
+        {
+            uint64_t m_Queries{0};
+            uint64_t m_FailedQueries{0};
+            uint64_t m_CacheHits{0};
+            uint64_t m_InputTokens{0};
+            uint64_t m_CachedTokens{0};
+            uint64_t m_OutputTokens{0};
+            uint64_t m_LatencyMicroseconds{0};
+            uint64_t m_CostMicroDollars{0};
+
+            double GetCost() const { return static_cast<double>(m_CostMicroDollars) / 1e6; }
+            double GetAverageLatencyMilliseconds() const;
+            // share of input tokens served from the provider's prompt cache, 0..1
+            double GetCachedTokenRate() const;
+        };
+
+        struct Snapshot
+        {
+            Totals m_Total;
+            std::vector<std::pair<std::string, Totals>> m_Sessions; // sorted by name
+            std::vector<std::pair<std::string, Totals>> m_Models;   // sorted by name
+        };
+
+    public:
+        static UsageMetrics& Get();
+
+        // maxBytes == 0 disables the log, the counters are always kept
+        void Load(fs::path const& logFilepath, size_t maxBytes);
+
+        // stable for the lifetime of the process
+        Counters* GetSessionCounters(std::string const& session);
+        Counters* GetModelCounters(std::string const& model);
+
+        // USD, from the prices per 1M tokens of the API interface
+        static double EstimateCost(ReplyParser::Usage const& usage,
+                                   ConfigParser::EngineConfig::ApiInterface const& apiInterface);
+
+        // lock-free, called from the thread pool
+        void Record(QueryResult const& result, Counters* sessionCounters, Counters* modelCounters);
+        void RecordCacheHit(Counters* sessionCounters, Counters* modelCounters);
+
+        // main thread only
+        void AppendToLog(std::string_view session, std::string_view model, QueryResult const& result);
+
+        Snapshot GetSnapshot() const;
+
+    private:
+        UsageMetrics() = default;
+        ~UsageMetrics() = default;
+
+        UsageMetrics(const UsageMetrics&) = delete;
+        UsageMetrics& operator=(const UsageMetrics&) = delete;
+
+    private:
+        static Totals Read(Counters const& counters);
+        fs::path GetRotatedFilepath(size_t index) const;
+        void Rotate();
+
+    private:
+        static constexpr size_t NUM_ROTATED_LOGS = 4;
+
+        Counters m_Total;
+        std::unordered_map<std::string, std::unique_ptr<Counters>> m_Sessions;
+        std::unordered_map<std::string, std::unique_ptr<Counters>> m_Models;
+        mutable std::mutex m_Mutex; // guards the maps, not the counters
+
+        fs::path m_LogFilepath;
+        size_t m_MaxLogBytes{0};
+        size_t m_LogBytes{0};
+        std::ofstream m_LogFile;
+    };
+} // namespace AIAssistant
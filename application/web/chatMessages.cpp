@@ -19,6 +19,8 @@
    TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
+#include <algorithm>
+
 #include "engine.h"
 #include "jarvisAgent.h"
 #include "chatMessages.h"
@@ -123,6 +125,26 @@ namespace AIAssistant
         App::g_App->GetWebServer()->BroadcastJSON(msg.dump());
     }
 
+    void ChatMessagePool::StreamDelta(uint64_t id, std::string_view delta)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            auto entry = std::find_if(m_Entries.begin(), m_Entries.end(), [id](ChatMessageEntry const& candidate)
+                                      { return candidate.id == id && !candidate.expired && !candidate.answered; });
+            if (entry == m_Entries.end())
+            {
+                return; // expired or answered, the browser is no longer waiting for it
+            }
+            entry->timestamp = std::chrono::steady_clock::now();
+        }
+
+        crow::json::wvalue msg;
+        msg["type"] = "output-delta";
+        msg["id"] = id;
+        msg["text"] = std::string(delta);
+        App::g_App->GetWebServer()->BroadcastJSON(msg.dump());
+    }
+
     void ChatMessagePool::RemoveExpired()
     {
         const auto now = std::chrono::steady_clock::now();
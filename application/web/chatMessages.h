@@ -21,6 +21,7 @@
 
 #pragma once
 #include <string>
+#include <string_view>
 #include <cstdint>
 #include <chrono>
 #include <queue>
@@ -46,6 +47,8 @@ namespace AIAssistant
 
         uint64_t AddMessage(std::string const& subsystem, std::string const& message);
         void MarkAnswered(uint64_t id, std::string const& answerText);
+        // forwards part of a streamed answer, keeps the message from expiring while it streams
+        void StreamDelta(uint64_t id, std::string_view delta);
         void RemoveExpired();
         void Update(); // called periodically to remove expired entries
 
@@ -28,6 +28,7 @@
 #include "jarvisAgent.h"
 #include "web/webServer.h"
 #include "web/chatMessages.h"
+#include "session/usageMetrics.h"
 
 #include "event/events.h"
 
@@ -67,6 +68,9 @@ namespace AIAssistant
 
         // ---- GET /api/status ----
         CROW_ROUTE(m_Server, "/api/status")([this]() { return HandleStatusGet(); });
+
+        // ---- GET /api/metrics ----
+        CROW_ROUTE(m_Server, "/api/metrics")([this]() { return HandleMetricsGet(); });
     }
 
     crow::response WebServer::HandleChatPost(const crow::request& req)
@@ -118,6 +122,52 @@ namespace AIAssistant
         return crow::response(200, status.dump());
     }
 
+    crow::response WebServer::HandleMetricsGet()
+    {
+        auto toJson = [](crow::json::wvalue& json, UsageMetrics::Totals const& totals)
+        {
+            json["queries"] = totals.m_Queries;
+            json["failed queries"] = totals.m_FailedQueries;
+            json["cache hits"] = totals.m_CacheHits;
+            json["input tokens"] = totals.m_InputTokens;
+            json["cached tokens"] = totals.m_CachedTokens;
+            json["cached token rate"] = totals.GetCachedTokenRate();
+            json["output tokens"] = totals.m_OutputTokens;
+            json["average latency ms"] = totals.GetAverageLatencyMilliseconds();
+            json["cost"] = totals.GetCost();
+        };
+
+        UsageMetrics::Snapshot snapshot = UsageMetrics::Get().GetSnapshot();
+
+        crow::json::wvalue metrics;
+        metrics["type"] = "metrics";
+        toJson(metrics["total"], snapshot.m_Total);
+        for (auto const& [name, totals] : snapshot.m_Sessions)
+        {
+            toJson(metrics["sessions"][name], totals);
+        }
+        for (auto const& [name, totals] : snapshot.m_Models)
+        {
+            toJson(metrics["models"][name], totals);
+        }
+
+        auto& curlMulti = Core::g_Core->GetCurlMulti();
+        for (size_t index = 0; index < CurlMulti::NUM_LANES; ++index)
+        {
+            auto lane = static_cast<CurlMulti::Lane>(index);
+            CurlMulti::LaneStatistics laneStatistics = curlMulti.GetLaneStatistics(lane);
+            crow::json::wvalue& json = metrics["lanes"][CurlMulti::GetLaneName(lane)];
+            json["queued"] = laneStatistics.m_Queued;
+            json["in flight"] = laneStatistics.m_InFlight;
+            json["completed"] = laneStatistics.m_Completed;
+            json["queue wait p50 ms"] = laneStatistics.m_QueueWaitP50Ms;
+            json["queue wait p99 ms"] = laneStatistics.m_QueueWaitP99Ms;
+            json["latency p50 ms"] = laneStatistics.m_LatencyP50Ms;
+            json["latency p99 ms"] = laneStatistics.m_LatencyP99Ms;
+        }
+        return crow::response(200, metrics.dump());
+    }
+
     void WebServer::RegisterWebSocket()
     {
         CROW_WEBSOCKET_ROUTE(m_Server, "/ws")
@@ -175,7 +225,7 @@ namespace AIAssistant
                         }
                         else if (type == "quit")
                         {
-                            auto event = std::make_shared<EngineEvent>(EngineEvent::EngineEventShutdown);
+                            auto event = EventPool::Create<EngineEvent>(EngineEvent::EngineEventShutdown);
                             Core::g_Core->PushEvent(event);
 
                             crow::json::wvalue response;
@@ -208,7 +258,8 @@ namespace AIAssistant
         }
 
         m_Running = true;
-        m_ServerTask = Core::g_Core->GetThreadPool().SubmitTask(
+        m_ServerTask = Core::g_Core->GetThreadPool().StartService(
+            "web server",
             [this]()
             {
                 LOG_APP_INFO("Crow web server started at http://localhost:8080");
@@ -50,6 +50,7 @@ namespace AIAssistant
         // Handlers
         crow::response HandleChatPost(crow::request const& req);
         crow::response HandleStatusGet();
+        crow::response HandleMetricsGet();
 
     private:
         crow::SimpleApp m_Server;
@@ -0,0 +1,159 @@
+/* Copyright (c) 2025 JC Technolabs
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+
+// Micro-benchmark for JsonHelper::SanitizeForJson against the original per-byte escaping loop.
+// Build with "premake5 gmake2 && make config=release jsonSanitizeBench", run bin/Release/jsonSanitizeBench.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+
+#include "json/jsonHelper.h"
+
+namespace AIAssistant
+{
+    // the implementation before SIMD scanning, kept verbatim as the baseline
+    std::string BaselineSanitizeForJson(std::string const& input)
+    {
+        std::string output;
+        output.reserve(input.size());
+
+        for (char c : input)
+        {
+            switch (c)
+            {
+                case '\f':
+                {
+                    break;
+                }
+                case '\"':
+                {
+                    output += "\\\"";
+                    break;
+                }
+                case '\\':
+                {
+                    output += "\\\\";
+                    break;
+                }
+                case '\n':
+                {
+                    output += "\\n";
+                    break;
+                }
+                case '\r':
+                {
+                    output += "\\r";
+                    break;
+                }
+                case '\t':
+                {
+                    output += "\\t";
+                    break;
+                }
+                default:
+                {
+                    output += c;
+                    break;
+                }
+            }
+        }
+
+        return output;
+    }
+
+    // prompt-like text: ASCII words, a quote or newline every ~60 bytes and some umlauts
+    std::string MakeInput(size_t size, std::mt19937& random)
+    {
+        std::string input;
+        input.reserve(size + 2);
+        while (input.size() < size)
+        {
+            if (random() % 60)
+            {
+                input += static_cast<char>('a' + random() % 26);
+            }
+            else
+            {
+                input += (random() % 2) ? '\n' : '"';
+            }
+            if (random() % 200 == 0)
+            {
+                input += "\xC3\xA4"; // ä
+            }
+        }
+        return input;
+    }
+
+    template <typename Function>
+    double Measure(std::string const& input, Function function)
+    {
+        // about 256 MB of input per measurement, best of five
+        size_t repetitions = std::max<size_t>(1, (256u << 20) / input.size());
+        double best{0.0};
+        for (int run = 0; run < 5; ++run)
+        {
+            size_t checksum{0};
+            auto start = std::chrono::steady_clock::now();
+            for (size_t repetition = 0; repetition < repetitions; ++repetition)
+            {
+                checksum += function(input).size();
+            }
+            std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+            double gigabytesPerSecond = static_cast<double>(repetitions * input.size()) / seconds.count() / 1e9;
+            best = std::max(best, gigabytesPerSecond);
+            if (checksum == 0)
+            {
+                std::printf("empty output\n");
+            }
+        }
+        return best;
+    }
+} // namespace AIAssistant
+
+int main()
+{
+    using namespace AIAssistant;
+
+    std::mt19937 random(3);
+    JsonHelper jsonHelper;
+    for (size_t size : {24u << 10, 256u << 10, 1u << 20})
+    {
+        std::string input = MakeInput(size, random);
+
+        // both escape this input identically, the new code only differs for control characters and bad UTF-8
+        if (BaselineSanitizeForJson(input) != jsonHelper.SanitizeForJson(input))
+        {
+            std::printf("output mismatch for %zu bytes\n", size);
+            return EXIT_FAILURE;
+        }
+
+        double baseline = Measure(input, [](std::string const& text) { return BaselineSanitizeForJson(text); });
+        double current = Measure(input, [&](std::string const& text) { return jsonHelper.SanitizeForJson(text); });
+        std::printf("%8zu bytes: baseline %6.2f GB/s, SanitizeForJson %6.2f GB/s (x%.1f)\n", size, baseline, current,
+                    current / baseline);
+    }
+    return EXIT_SUCCESS;
+}
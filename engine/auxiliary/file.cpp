@@ -21,6 +21,10 @@
 
 #include "auxiliary/file.h"
 
+#ifndef _WIN32
+#include <sys/stat.h>
+#endif
+
 namespace AIAssistant
 {
     namespace EngineCore
@@ -192,5 +196,51 @@ namespace AIAssistant
             return newest;
         }
 
+        bool GetFileStat(const std::filesystem::path& path, FileStat& fileStat)
+        {
+#ifndef _WIN32
+            struct stat statBuffer{};
+            if (::stat(path.c_str(), &statBuffer) != 0)
+            {
+                return false;
+            }
+            fileStat.m_Size = static_cast<uint64_t>(statBuffer.st_size);
+#ifdef __APPLE__
+            struct timespec const& lastWriteTime = statBuffer.st_mtimespec;
+#else
+            struct timespec const& lastWriteTime = statBuffer.st_mtim;
+#endif
+            fileStat.m_LastWriteTime = static_cast<int64_t>(lastWriteTime.tv_sec) * 1000000000 + lastWriteTime.tv_nsec;
+            fileStat.m_Inode = static_cast<uint64_t>(statBuffer.st_ino);
+            return true;
+#else
+            std::error_code errorCode;
+            auto size = std::filesystem::file_size(path, errorCode);
+            if (errorCode)
+            {
+                return false;
+            }
+            auto lastWriteTime = std::filesystem::last_write_time(path, errorCode);
+            if (errorCode)
+            {
+                return false;
+            }
+            fileStat.m_Size = static_cast<uint64_t>(size);
+            fileStat.m_LastWriteTime =
+                std::chrono::duration_cast<std::chrono::nanoseconds>(lastWriteTime.time_since_epoch()).count();
+            fileStat.m_Inode = 0; // not available
+            return true;
+#endif
+        }
+
+        FilePtr OpenFileForReading(const std::filesystem::path& path)
+        {
+#ifdef _WIN32
+            // path::c_str() is wchar_t const* there
+            return FilePtr(::_wfopen(path.c_str(), L"rb"), &std::fclose);
+#else
+            return FilePtr(std::fopen(path.c_str(), "rb"), &std::fclose);
+#endif
+        }
     } // namespace EngineCore
 } // namespace AIAssistant
@@ -25,6 +25,9 @@
 #include <fstream>
 #include <filesystem>
 #include <vector>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
 
 namespace fs = std::filesystem;
 
@@ -52,5 +55,21 @@ namespace AIAssistant
         std::ifstream::pos_type FileSize(const std::string& filename);
         std::string& AddSlash(std::string& filename);
         fs::file_time_type GetNewestTimestamp(std::vector<fs::path> const& files);
+
+        struct FileStat
+        {
+            uint64_t m_Size{0};
+            int64_t m_LastWriteTime{0}; // in ns
+            uint64_t m_Inode{0};
+
+            bool operator==(FileStat const&) const = default;
+        };
+
+        // one stat() call, returns false if the file can't be accessed
+        bool GetFileStat(const std::filesystem::path& path, FileStat& fileStat);
+
+        // binary read-only C stream, closed with the pointer; null if the file can't be opened
+        using FilePtr = std::unique_ptr<std::FILE, decltype(&std::fclose)>;
+        FilePtr OpenFileForReading(const std::filesystem::path& path);
     } // namespace EngineCore
 } // namespace AIAssistant
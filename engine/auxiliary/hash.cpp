@@ -0,0 +1,270 @@
+/* Copyright (c) 2025 JC Technolabs
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+#include <bit>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+
+#include <openssl/evp.h>
+
+#include "core.h"
+#include "auxiliary/hash.h"
+#include "auxiliary/file.h"
+
+namespace AIAssistant
+{
+    namespace EngineCore
+    {
+        // --- XXH64, see https://github.com/Cyan4973/xxHash/blob/dev/doc/xxhash_spec.md ---
+        static constexpr uint64_t PRIME64_1 = 0x9E3779B185EBCA87ULL;
+        static constexpr uint64_t PRIME64_2 = 0xC2B2AE3D27D4EB4FULL;
+        static constexpr uint64_t PRIME64_3 = 0x165667B19E3779F9ULL;
+        static constexpr uint64_t PRIME64_4 = 0x85EBCA77C2B2AE63ULL;
+        static constexpr uint64_t PRIME64_5 = 0x27D4EB2F165667C5ULL;
+
+        static uint64_t Read64(uint8_t const* data)
+        {
+            uint64_t value;
+            std::memcpy(&value, data, sizeof(value));
+            return value; // little endian hosts only
+        }
+
+        static uint32_t Read32(uint8_t const* data)
+        {
+            uint32_t value;
+            std::memcpy(&value, data, sizeof(value));
+            return value;
+        }
+
+        static uint64_t Xxh64Round(uint64_t accumulator, uint64_t input)
+        {
+            accumulator += input * PRIME64_2;
+            accumulator = std::rotl(accumulator, 31);
+            return accumulator * PRIME64_1;
+        }
+
+        static uint64_t Xxh64MergeRound(uint64_t accumulator, uint64_t value)
+        {
+            accumulator ^= Xxh64Round(0, value);
+            return accumulator * PRIME64_1 + PRIME64_4;
+        }
+
+        std::string Digest::ToHex() const
+        {
+            static constexpr char hexDigits[] = "0123456789abcdef";
+            std::string hex(2 * m_Size, '0');
+            for (size_t index = 0; index < m_Size; ++index)
+            {
+                hex[2 * index] = hexDigits[m_Bytes[index] >> 4];
+                hex[2 * index + 1] = hexDigits[m_Bytes[index] & 0x0F];
+            }
+            return hex;
+        }
+
+        Hasher::Hasher(HashAlgorithm hashAlgorithm) : m_HashAlgorithm{hashAlgorithm}
+        {
+            switch (m_HashAlgorithm)
+            {
+                case HashAlgorithm::Xxh64:
+                {
+                    m_Accumulators = {PRIME64_1 + PRIME64_2, PRIME64_2, 0, 0 - PRIME64_1};
+                    break;
+                }
+                case HashAlgorithm::Sha256:
+                default:
+                {
+                    m_HashAlgorithm = HashAlgorithm::Sha256;
+                    m_Sha256Context = EVP_MD_CTX_new();
+                    EVP_DigestInit_ex(m_Sha256Context, EVP_sha256(), nullptr);
+                    break;
+                }
+            }
+        }
+
+        Hasher::~Hasher()
+        {
+            if (m_Sha256Context != nullptr)
+            {
+                EVP_MD_CTX_free(m_Sha256Context);
+            }
+        }
+
+        void Hasher::Update(void const* data, size_t size)
+        {
+            if (m_HashAlgorithm == HashAlgorithm::Xxh64)
+            {
+                UpdateXxh64(static_cast<uint8_t const*>(data), size);
+            }
+            else
+            {
+                EVP_DigestUpdate(m_Sha256Context, data, size);
+            }
+        }
+
+        bool Hasher::UpdateFromFile(std::FILE* file)
+        {
+            static constexpr size_t BLOCK_SIZE = 64 * 1024;
+            thread_local std::unique_ptr<char[]> block = std::make_unique<char[]>(BLOCK_SIZE);
+
+            size_t bytesRead;
+            while ((bytesRead = std::fread(block.get(), 1, BLOCK_SIZE, file)) > 0)
+            {
+                Update(block.get(), bytesRead);
+            }
+            return !std::ferror(file);
+        }
+
+        Digest Hasher::Finalize()
+        {
+            if (m_HashAlgorithm == HashAlgorithm::Xxh64)
+            {
+                return FinalizeXxh64();
+            }
+
+            Digest digest;
+            unsigned int size{0};
+            EVP_DigestFinal_ex(m_Sha256Context, digest.m_Bytes.data(), &size);
+            digest.m_Size = static_cast<uint8_t>(size);
+            return digest;
+        }
+
+        void Hasher::UpdateXxh64(uint8_t const* data, size_t size)
+        {
+            m_TotalSize += size;
+
+            // complete a stripe left over from the previous call
+            if (m_StripeSize > 0)
+            {
+                size_t const fill = std::min(size, m_Stripe.size() - m_StripeSize);
+                std::memcpy(m_Stripe.data() + m_StripeSize, data, fill);
+                m_StripeSize += fill;
+                data += fill;
+                size -= fill;
+                if (m_StripeSize < m_Stripe.size())
+                {
+                    return;
+                }
+                for (size_t lane = 0; lane < 4; ++lane)
+                {
+                    m_Accumulators[lane] = Xxh64Round(m_Accumulators[lane], Read64(m_Stripe.data() + 8 * lane));
+                }
+                m_StripeSize = 0;
+            }
+
+            // full stripes straight from the input
+            while (size >= m_Stripe.size())
+            {
+                for (size_t lane = 0; lane < 4; ++lane)
+                {
+                    m_Accumulators[lane] = Xxh64Round(m_Accumulators[lane], Read64(data + 8 * lane));
+                }
+                data += m_Stripe.size();
+                size -= m_Stripe.size();
+            }
+
+            std::memcpy(m_Stripe.data(), data, size);
+            m_StripeSize = size;
+        }
+
+        Digest Hasher::FinalizeXxh64()
+        {
+            uint64_t hash;
+            if (m_TotalSize >= m_Stripe.size())
+            {
+                hash = std::rotl(m_Accumulators[0], 1) + std::rotl(m_Accumulators[1], 7) +
+                       std::rotl(m_Accumulators[2], 12) + std::rotl(m_Accumulators[3], 18);
+                for (uint64_t accumulator : m_Accumulators)
+                {
+                    hash = Xxh64MergeRound(hash, accumulator);
+                }
+            }
+            else
+            {
+                hash = PRIME64_5;
+            }
+            hash += m_TotalSize;
+
+            uint8_t const* data = m_Stripe.data();
+            uint8_t const* const end = data + m_StripeSize;
+            for (; data + 8 <= end; data += 8)
+            {
+                hash ^= Xxh64Round(0, Read64(data));
+                hash = std::rotl(hash, 27) * PRIME64_1 + PRIME64_4;
+            }
+            if (data + 4 <= end)
+            {
+                hash ^= static_cast<uint64_t>(Read32(data)) * PRIME64_1;
+                hash = std::rotl(hash, 23) * PRIME64_2 + PRIME64_3;
+                data += 4;
+            }
+            for (; data < end; ++data)
+            {
+                hash ^= (*data) * PRIME64_5;
+                hash = std::rotl(hash, 11) * PRIME64_1;
+            }
+
+            hash ^= hash >> 33;
+            hash *= PRIME64_2;
+            hash ^= hash >> 29;
+            hash *= PRIME64_3;
+            hash ^= hash >> 32;
+
+            Digest digest;
+            digest.m_Size = sizeof(hash);
+            for (size_t index = 0; index < sizeof(hash); ++index)
+            {
+                digest.m_Bytes[index] = static_cast<uint8_t>(hash >> (56 - 8 * index));
+            }
+            return digest;
+        }
+
+        HashAlgorithm GetHashAlgorithm()
+        {
+            return (Core::g_Core != nullptr) ? Core::g_Core->GetConfig().m_HashAlgorithm : HashAlgorithm::Sha256;
+        }
+
+        Digest ComputeHash(std::string_view data)
+        {
+            Hasher hasher(GetHashAlgorithm());
+            hasher.Update(data.data(), data.size());
+            return hasher.Finalize();
+        }
+
+        bool ComputeFileHash(std::filesystem::path const& path, Digest& digest)
+        {
+            FilePtr file = OpenFileForReading(path);
+            if (!file)
+            {
+                return false;
+            }
+
+            Hasher hasher(GetHashAlgorithm());
+            if (!hasher.UpdateFromFile(file.get()))
+            {
+                return false;
+            }
+
+            digest = hasher.Finalize();
+            return true;
+        }
+    } // namespace EngineCore
+} // namespace AIAssistant
@@ -0,0 +1,90 @@
+/* Copyright (c) 2025 JC Technolabs
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+#include <openssl/types.h>
+
+#include "json/configParser.h"
+
+namespace AIAssistant
+{
+    namespace EngineCore
+    {
+        using HashAlgorithm = ConfigParser::EngineConfig::HashAlgorithm;
+
+        // raw digest bytes, SHA-256 uses all 32, XXH64 the first 8 (big endian)
+        struct Digest
+        {
+            std::array<uint8_t, 32> m_Bytes{};
+            uint8_t m_Size{0};
+
+            bool IsEmpty() const { return m_Size == 0; }
+            std::string ToHex() const;
+            bool operator==(Digest const&) const = default;
+        };
+
+        // incremental hashing, data can be fed in chunks of any size
+        class Hasher
+        {
+        public:
+            explicit Hasher(HashAlgorithm hashAlgorithm);
+            ~Hasher();
+
+            Hasher(const Hasher&) = delete;
+            Hasher& operator=(const Hasher&) = delete;
+
+            void Update(void const* data, size_t size);
+            // feeds everything from the current position to the end of the file
+            bool UpdateFromFile(std::FILE* file);
+            Digest Finalize();
+
+        private:
+            void UpdateXxh64(uint8_t const* data, size_t size);
+            Digest FinalizeXxh64();
+
+        private:
+            HashAlgorithm m_HashAlgorithm;
+            EVP_MD_CTX* m_Sha256Context{nullptr};
+
+            // XXH64 state
+            std::array<uint64_t, 4> m_Accumulators{};
+            std::array<uint8_t, 32> m_Stripe{};
+            size_t m_StripeSize{0};
+            uint64_t m_TotalSize{0};
+        };
+
+        // algorithm selected in config.json ("hash algorithm")
+        HashAlgorithm GetHashAlgorithm();
+
+        Digest ComputeHash(std::string_view data);
+
+        // streams the file in fixed-size blocks, memory use does not depend on the file size
+        bool ComputeFileHash(std::filesystem::path const& path, Digest& digest);
+    } // namespace EngineCore
+} // namespace AIAssistant
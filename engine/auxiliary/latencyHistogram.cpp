@@ -0,0 +1,70 @@
+/* Copyright (c) 2025 JC Technolabs
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+#include "auxiliary/latencyHistogram.h"
+
+namespace AIAssistant
+{
+    void LatencyHistogram::Record(std::chrono::steady_clock::duration latency)
+    {
+        auto milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(latency).count();
+        // bucket n holds latencies below 2^n ms
+        size_t bucket = std::bit_width(static_cast<uint64_t>(std::max<int64_t>(milliseconds, 0)));
+        bucket = std::min(bucket, NUM_BUCKETS - 1);
+        m_Buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    uint64_t LatencyHistogram::GetCount() const
+    {
+        uint64_t count{0};
+        for (auto const& bucket : m_Buckets)
+        {
+            count += bucket.load(std::memory_order_relaxed);
+        }
+        return count;
+    }
+
+    uint64_t LatencyHistogram::GetPercentileMilliseconds(double percentile) const
+    {
+        uint64_t count = GetCount();
+        if (count == 0)
+        {
+            return 0;
+        }
+
+        auto rank = static_cast<uint64_t>(std::ceil(std::clamp(percentile, 0.0, 100.0) / 100.0 * count));
+        rank = std::max<uint64_t>(rank, 1);
+        uint64_t seen{0};
+        for (size_t bucket = 0; bucket < NUM_BUCKETS; ++bucket)
+        {
+            seen += m_Buckets[bucket].load(std::memory_order_relaxed);
+            if (seen >= rank)
+            {
+                return uint64_t{1} << bucket;
+            }
+        }
+        return uint64_t{1} << (NUM_BUCKETS - 1);
+    }
+} // namespace AIAssistant
@@ -0,0 +1,47 @@
+/* Copyright (c) 2025 JC Technolabs
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace AIAssistant
+{
+    // Lock-free latency distribution for percentiles such as p50 and p99.
+    // Buckets double in width from 1 ms up to about 9 minutes, so a percentile
+    // is exact to within a factor of two, which is what a dashboard needs.
+    class LatencyHistogram
+    {
+    public:
+        void Record(std::chrono::steady_clock::duration latency);
+
+        uint64_t GetCount() const;
+        // upper bound of the bucket holding the percentile (0..100), 0 without samples
+        uint64_t GetPercentileMilliseconds(double percentile) const;
+
+    private:
+        static constexpr size_t NUM_BUCKETS = 20;
+
+        std::array<std::atomic<uint64_t>, NUM_BUCKETS> m_Buckets{};
+    };
+} // namespace AIAssistant
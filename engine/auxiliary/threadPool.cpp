@@ -19,16 +19,243 @@
    TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
+#include "tracy/Tracy.hpp"
+
 #include "auxiliary/threadPool.h"
 
 namespace AIAssistant
 {
-    ThreadPool::ThreadPool() {}
+    // the worker a thread belongs to, for submissions from inside the pool
+    static thread_local ThreadPool const* t_Pool{nullptr};
+    static thread_local size_t t_WorkerIndex{0};
+
+    ThreadPool::ThreadPool() { Reset(std::thread::hardware_concurrency()); }
+
+    ThreadPool::~ThreadPool()
+    {
+        Wait();
+        StopWorkers();
+
+        // their owners have stopped them by now
+        std::lock_guard<std::mutex> guard(m_ServiceMutex);
+        for (auto& serviceThread : m_ServiceThreads)
+        {
+            if (serviceThread.joinable())
+            {
+                serviceThread.join();
+            }
+        }
+    }
+
+    void ThreadPool::Reset(size_t const numThreads)
+    {
+        Wait();
+        StopWorkers();
+
+        size_t const workerCount = std::max<size_t>(numThreads, 1);
+        m_MaxRunningBulk = std::max<size_t>(workerCount - 1, 1);
+        {
+            std::lock_guard<std::mutex> guard(m_SleepMutex);
+            m_Stop = false;
+        }
+
+        m_Workers.clear();
+        for (size_t index = 0; index < workerCount; ++index)
+        {
+            m_Workers.push_back(std::make_unique<Worker>());
+        }
+        for (size_t index = 0; index < workerCount; ++index)
+        {
+            m_Workers[index]->m_Thread = std::thread(&ThreadPool::WorkerLoop, this, index);
+        }
+    }
+
+    void ThreadPool::StopWorkers()
+    {
+        {
+            std::lock_guard<std::mutex> guard(m_SleepMutex);
+            m_Stop = true;
+        }
+        m_WorkAvailable.notify_all();
+
+        for (auto& worker : m_Workers)
+        {
+            if (worker->m_Thread.joinable())
+            {
+                worker->m_Thread.join();
+            }
+        }
+    }
+
+    size_t ThreadPool::Size() const { return m_Workers.size(); }
+
+    std::vector<std::thread::id> ThreadPool::GetThreadIDs() const
+    {
+        std::vector<std::thread::id> threadIDs;
+        for (auto const& worker : m_Workers)
+        {
+            threadIDs.push_back(worker->m_Thread.get_id());
+        }
+        return threadIDs;
+    }
+
+    bool ThreadPool::IsAllDone() const
+    {
+        size_t queued = 0;
+        for (auto const& count : m_Queued)
+        {
+            queued += count.load();
+        }
+        return queued == 0 && m_Running.load() == 0;
+    }
+
+    void ThreadPool::Wait()
+    {
+        std::unique_lock<std::mutex> lock(m_SleepMutex);
+        m_Waiters.fetch_add(1);
+        m_AllDone.wait(lock, [this]() { return IsAllDone(); });
+        m_Waiters.fetch_sub(1);
+    }
+
+    void ThreadPool::WakeWorker()
+    {
+        if (m_SleepingWorkers.load() == 0)
+        {
+            return; // all busy, each looks for work before it sleeps
+        }
+        // a sleeper checks the counts under the mutex, passing through it means it either saw
+        // them or is waiting and gets the notification
+        {
+            std::lock_guard<std::mutex> guard(m_SleepMutex);
+        }
+        m_WorkAvailable.notify_one();
+    }
+
+    void ThreadPool::Enqueue(Task task, Priority priority)
+    {
+        size_t const priorityIndex = static_cast<size_t>(priority);
+
+        // from a worker: keep it local, the data is likely still in its cache
+        size_t workerIndex = (t_Pool == this) ? t_WorkerIndex : m_NextWorker.fetch_add(1, std::memory_order_relaxed);
+        Worker& worker = *m_Workers[workerIndex % m_Workers.size()];
+
+        // counted before it is visible, a thief can never take it while it's not counted
+        m_Queued[priorityIndex].fetch_add(1);
+        {
+            std::lock_guard<std::mutex> guard(worker.m_Mutex);
+            worker.m_Queues[priorityIndex].push_back(std::move(task));
+        }
+        WakeWorker();
+    }
+
+    void ThreadPool::StartServiceThread(char const* name, std::packaged_task<void()> loop)
+    {
+        std::lock_guard<std::mutex> guard(m_ServiceMutex);
+        m_ServiceThreads.emplace_back(
+            [name, loop = std::move(loop)]() mutable
+            {
+                tracy::SetThreadName(name);
+                loop();
+            });
+    }
+
+    bool ThreadPool::CanRunBulk() const { return m_RunningBulk.load() < m_MaxRunningBulk; }
+
+    bool ThreadPool::TryPop(size_t workerIndex, Task& task, Priority& priority)
+    {
+        size_t const workerCount = m_Workers.size();
+        for (size_t priorityIndex = 0; priorityIndex < NUM_PRIORITIES; ++priorityIndex)
+        {
+            if (m_Queued[priorityIndex].load() == 0)
+            {
+                continue;
+            }
+            bool const isBulk = (priorityIndex == static_cast<size_t>(Priority::Bulk));
+            if (isBulk && !CanRunBulk())
+            {
+                continue;
+            }
+
+            // own deque from the front (submission order), others' from the back
+            for (size_t offset = 0; offset < workerCount; ++offset)
+            {
+                Worker& worker = *m_Workers[(workerIndex + offset) % workerCount];
+                std::lock_guard<std::mutex> guard(worker.m_Mutex);
+                auto& queue = worker.m_Queues[priorityIndex];
+                if (queue.empty())
+                {
+                    continue;
+                }
+                if (offset == 0)
+                {
+                    task = std::move(queue.front());
+                    queue.pop_front();
+                }
+                else
+                {
+                    task = std::move(queue.back());
+                    queue.pop_back();
+                }
+                priority = static_cast<Priority>(priorityIndex);
+
+                // counted as running before it stops counting as queued, Wait() never sees zero in between
+                m_Running.fetch_add(1);
+                if (isBulk)
+                {
+                    m_RunningBulk.fetch_add(1);
+                }
+                m_Queued[priorityIndex].fetch_sub(1);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void ThreadPool::WorkerLoop(size_t workerIndex)
+    {
+        t_Pool = this;
+        t_WorkerIndex = workerIndex;
+        tracy::SetThreadName("thread pool worker");
 
-    void ThreadPool::Wait() { m_Pool.wait(); }
+        for (;;)
+        {
+            Task task;
+            Priority priority{Priority::Normal};
+            if (!TryPop(workerIndex, task, priority))
+            {
+                std::unique_lock<std::mutex> lock(m_SleepMutex);
+                m_SleepingWorkers.fetch_add(1);
+                m_WorkAvailable.wait(lock,
+                                     [this]()
+                                     {
+                                         return m_Stop || m_Queued[0].load() || m_Queued[1].load() ||
+                                                (m_Queued[2].load() && CanRunBulk());
+                                     });
+                m_SleepingWorkers.fetch_sub(1);
+                if (m_Stop)
+                {
+                    return;
+                }
+                continue;
+            }
 
-    void ThreadPool::Reset(size_t const numThreads) { m_Pool.reset(numThreads); }
+            task();
 
-    [[nodiscard]] size_t ThreadPool::Size() const { return m_Pool.get_thread_count(); }
+            m_Running.fetch_sub(1);
+            if (priority == Priority::Bulk)
+            {
+                m_RunningBulk.fetch_sub(1);
+                WakeWorker(); // a bulk slot became free
+            }
 
+            // same handshake as WakeWorker(), with the threads in Wait()
+            if ((m_Waiters.load() != 0) && IsAllDone())
+            {
+                {
+                    std::lock_guard<std::mutex> guard(m_SleepMutex);
+                }
+                m_AllDone.notify_all();
+            }
+        }
+    }
 } // namespace AIAssistant
@@ -20,32 +20,148 @@
    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 #pragma once
-#include <iostream>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <memory>
 #include <mutex>
-#include "BS_thread_pool/BS_thread_pool.hpp"
+#include <thread>
+#include <type_traits>
+#include <vector>
 
 namespace AIAssistant
 {
+    // Work-stealing task scheduler.
+    // Every worker owns one deque per priority. Tasks submitted from a worker go to its own deques,
+    // tasks from other threads are spread round-robin. An idle worker takes the most urgent task
+    // it can find: its own deque first, then the other workers' deques, priority by priority,
+    // so interactive work anywhere runs before bulk work queued locally. Bulk tasks may occupy
+    // all workers but one, which keeps a worker free for interactive and normal tasks.
+    // Blocking loops (file watcher, web server, curl event loop, keyboard) don't belong on a
+    // worker, they get a dedicated service thread from StartService().
     class ThreadPool
     {
+    public:
+        enum class Priority
+        {
+            Interactive = 0, // the user is waiting, e.g. web chat
+            Normal,
+            Bulk, // large batches, e.g. document chunks
+            NumPriorities
+        };
 
     public:
         ThreadPool();
+        ~ThreadPool();
 
+        // waits until all queued tasks have run, service threads are not waited for
         void Wait();
         void Reset(size_t const numThreads);
         [[nodiscard]] size_t Size() const;
 
         template <typename FunctionType, typename ReturnType = std::invoke_result_t<std::decay_t<FunctionType>>>
-        [[nodiscard]] std::future<ReturnType> SubmitTask(FunctionType&& task)
+        [[nodiscard]] std::future<ReturnType> SubmitTask(FunctionType&& task, Priority priority = Priority::Normal)
+        {
+            auto packagedTask = std::make_shared<std::packaged_task<ReturnType()>>(std::forward<FunctionType>(task));
+            std::future<ReturnType> future = packagedTask->get_future();
+            Enqueue(Task([packagedTask]() { (*packagedTask)(); }), priority);
+            return future;
+        }
+
+        // fire-and-forget, the task must report its result by other means
+        template <typename FunctionType>
+        void DetachTask(FunctionType&& task, Priority priority = Priority::Normal)
+        {
+            Enqueue(Task(std::forward<FunctionType>(task)), priority);
+        }
+
+        // runs a long-lived, blocking loop on its own thread, outside the worker count
+        template <typename FunctionType>
+        [[nodiscard]] std::future<void> StartService(char const* name, FunctionType&& loop)
         {
-            std::lock_guard<std::mutex> guard(m_Mutex);
-            return m_Pool.submit_task(task);
+            std::packaged_task<void()> packagedTask(std::forward<FunctionType>(loop));
+            std::future<void> future = packagedTask.get_future();
+            StartServiceThread(name, std::move(packagedTask));
+            return future;
         }
-        [[nodiscard]] std::vector<std::thread::id> GetThreadIDs() const { return m_Pool.get_thread_ids(); }
+
+        [[nodiscard]] std::vector<std::thread::id> GetThreadIDs() const;
+
+    private:
+        // move-only type-erased callable, a std::function would require copyable tasks
+        class Task
+        {
+        public:
+            Task() = default;
+            template <typename FunctionType>
+            explicit Task(FunctionType&& function)
+                : m_Callable(std::make_unique<Callable<std::decay_t<FunctionType>>>(std::forward<FunctionType>(function)))
+            {
+            }
+
+            void operator()() { m_Callable->Invoke(); }
+            explicit operator bool() const { return m_Callable != nullptr; }
+
+        private:
+            struct CallableBase
+            {
+                virtual ~CallableBase() = default;
+                virtual void Invoke() = 0;
+            };
+
+            template <typename FunctionType>
+            struct Callable : CallableBase
+            {
+                explicit Callable(FunctionType&& function) : m_Function(std::move(function)) {}
+                explicit Callable(FunctionType const& function) : m_Function(function) {}
+                void Invoke() override { m_Function(); }
+                FunctionType m_Function;
+            };
+
+            std::unique_ptr<CallableBase> m_Callable;
+        };
+
+        struct alignas(64) Worker
+        {
+            std::mutex m_Mutex; // owner and thieves, held for a deque operation only
+            std::array<std::deque<Task>, static_cast<size_t>(Priority::NumPriorities)> m_Queues;
+            std::thread m_Thread;
+        };
 
     private:
-        BS::thread_pool<> m_Pool;
-        std::mutex m_Mutex;
+        void Enqueue(Task task, Priority priority);
+        void StartServiceThread(char const* name, std::packaged_task<void()> loop);
+        void WorkerLoop(size_t workerIndex);
+        bool TryPop(size_t workerIndex, Task& task, Priority& priority);
+        bool CanRunBulk() const;
+        void StopWorkers();
+        void WakeWorker();
+        bool IsAllDone() const;
+
+    private:
+        static constexpr size_t NUM_PRIORITIES = static_cast<size_t>(Priority::NumPriorities);
+
+        std::vector<std::unique_ptr<Worker>> m_Workers;
+        std::atomic<size_t> m_NextWorker{0};
+
+        // counts drive sleeping, waking and Wait()
+        std::array<std::atomic<size_t>, NUM_PRIORITIES> m_Queued{};
+        std::atomic<size_t> m_Running{0};
+        std::atomic<size_t> m_RunningBulk{0};
+        size_t m_MaxRunningBulk{1};
+
+        // taken only when someone sleeps: a sleeper registers before it checks the counts,
+        // a producer or finishing task checks for sleepers after it changed them
+        std::mutex m_SleepMutex;
+        std::condition_variable m_WorkAvailable;
+        std::condition_variable m_AllDone;
+        std::atomic<size_t> m_SleepingWorkers{0};
+        std::atomic<size_t> m_Waiters{0}; // threads in Wait()
+        bool m_Stop{false};
+
+        std::mutex m_ServiceMutex;
+        std::vector<std::thread> m_ServiceThreads;
     };
 } // namespace AIAssistant
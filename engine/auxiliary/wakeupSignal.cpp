@@ -0,0 +1,46 @@
+/* Copyright (c) 2025 JC Technolabs
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+#include "auxiliary/wakeupSignal.h"
+
+namespace AIAssistant
+{
+    void WakeupSignal::Notify()
+    {
+        if (m_Pending.exchange(true))
+        {
+            return; // already pending, the waiter will see it
+        }
+
+        // taking the lock orders this notification after the waiter's predicate check
+        {
+            std::lock_guard<std::mutex> guard(m_Mutex);
+        }
+        m_Condition.notify_one();
+    }
+
+    bool WakeupSignal::WaitUntil(std::chrono::steady_clock::time_point deadline)
+    {
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        m_Condition.wait_until(lock, deadline, [this]() { return m_Pending.load(); });
+        return m_Pending.exchange(false);
+    }
+} // namespace AIAssistant
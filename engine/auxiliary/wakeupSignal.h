@@ -20,17 +20,27 @@
    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 #pragma once
-#include "curlWrapper/curlWrapper.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
 
 namespace AIAssistant
 {
-    class CurlManager
+    // Lets the run loop sleep until there is something to do.
+    // Any thread calls Notify(); repeated notifications before the loop wakes up
+    // collapse into one and cost a single atomic exchange.
+    class WakeupSignal
     {
     public:
-        static CurlWrapper& GetThreadCurl()
-        {
-            thread_local CurlWrapper curl; // unique per thread, created once, destroyed when thread exits
-            return curl;
-        }
+        void Notify();
+
+        // returns true if notified, false if the deadline passed first
+        bool WaitUntil(std::chrono::steady_clock::time_point deadline);
+
+    private:
+        std::atomic<bool> m_Pending{false};
+        std::mutex m_Mutex;
+        std::condition_variable m_Condition;
     };
-} // namespace AIAssistant
\ No newline at end of file
+} // namespace AIAssistant
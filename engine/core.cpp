@@ -20,6 +20,7 @@
    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 #include <csignal>
+#include <cstdlib>
 #ifndef _WIN32
 #include <termios.h>
 #include <unistd.h>
@@ -88,19 +89,16 @@ namespace AIAssistant
 
     void Core::SignalHandler(int signal)
     {
-        static bool sigIntReceived{false};
-        if ((signal == SIGINT) && sigIntReceived)
+        if (signal != SIGINT)
         {
-            LOG_CORE_INFO("force shudown");
-            // force shudown
-            exit(EXIT_FAILURE);
+            return;
         }
-        if (signal == SIGINT)
+        // only a lock-free atomic here: no logging, no allocation, no locks;
+        // the run loop turns it into a shutdown event within one frame
+        if (g_Core->m_SigIntReceived.exchange(true))
         {
-            sigIntReceived = true;
-            LOG_CORE_INFO("Received signal SIGINT, exiting");
-            auto event = std::make_shared<EngineEvent>(EngineEvent::EngineEventShutdown);
-            g_Core->PushEvent(event);
+            // force shutdown
+            std::_Exit(EXIT_FAILURE);
         }
     }
 
@@ -122,15 +120,31 @@ namespace AIAssistant
 #endif
     }
 
-    void Core::PushEvent(EventQueue::EventPtr eventPtr) { m_EventQueue.Push(std::move(eventPtr)); }
+    void Core::PushEvent(EventQueue::EventPtr eventPtr)
+    {
+        m_EventQueue.Push(std::move(eventPtr));
+        m_WakeupSignal.Notify();
+    }
+
+    void Core::WakeUp() { m_WakeupSignal.Notify(); }
 
     void Core::Start(ConfigParser::EngineConfig const& engineConfig)
     {
         m_EngineConfig = engineConfig;
 
-        m_ThreadPool.Reset(m_EngineConfig.m_MaxThreads + THREADS_REQUIRED_BY_APP);
+        // file watcher, keyboard input, web server, and curl event loop run on service threads of their own
+        m_ThreadPool.Reset(m_EngineConfig.m_MaxThreads);
         LOG_CORE_INFO("thread count: {}", m_ThreadPool.Size());
 
+        m_CurlMulti.Start(
+            RateLimiter::Limits{
+                .m_RequestsPerMinute = static_cast<double>(m_EngineConfig.m_RequestsPerMinute), //
+                .m_TokensPerMinute = static_cast<double>(m_EngineConfig.m_TokensPerMinute),     //
+                .m_MaxConcurrency = m_EngineConfig.m_MaxConcurrentQueries,                      //
+                .m_MaxRetries = m_EngineConfig.m_MaxRetries                                     //
+            },
+            m_EngineConfig.m_ReservedInteractiveQueries);
+
         m_KeyboardInput = std::make_unique<KeyboardInput>();
         m_KeyboardInput->Start();
 
@@ -144,9 +158,15 @@ namespace AIAssistant
     {
         tracy::SetThreadName("main thread (run loop)");
 
+        CORE_ASSERT((m_EngineConfig.m_SleepDuration > 0ms) && (m_EngineConfig.m_SleepDuration <= 256ms),
+                    "sleep duration incorrect");
+
+        auto lastRenderTime = std::chrono::steady_clock::time_point{};
+
         // run loop
         do
         {
+            auto const frameStart = std::chrono::steady_clock::now();
             {
                 ZoneScopedN("application->OnUpdate");
                 app->OnUpdate();
@@ -156,10 +176,19 @@ namespace AIAssistant
                 const auto green = 0x00ff00;
                 ZoneScopedNC("event handling", green);
 
+                if (m_SigIntReceived.load() && !m_SigIntHandled)
+                {
+                    m_SigIntHandled = true;
+                    LOG_CORE_INFO("Received signal SIGINT, exiting");
+                    // pushed from the consumer thread, never dropped when the ring is full
+                    PushEvent(EventPool::Create<EngineEvent>(EngineEvent::EngineEventShutdown));
+                }
+
                 // pop all pending events from queue
-                auto events = m_EventQueue.PopAll();
+                m_Events.clear();
+                m_EventQueue.PopAll(m_Events);
 
-                for (auto& eventPtr : events)
+                for (auto& eventPtr : m_Events)
                 {
                     Event& event = *eventPtr;
                     EventDispatcher dispatcher(event);
@@ -178,30 +207,43 @@ namespace AIAssistant
                         app->OnEvent(eventPtr);
                     }
                 }
+
+                // the application reacts to events in OnUpdate(), give it the next frame right away
+                if (!m_Events.empty())
+                {
+                    m_WakeupSignal.Notify();
+                }
             }
 
-            if (m_TerminalManager)
+            // wakeups can come much faster than the terminal needs to be redrawn
+            if (m_TerminalManager && ((frameStart - lastRenderTime) >= m_EngineConfig.m_SleepDuration))
             {
                 m_TerminalManager->Render();
+                lastRenderTime = frameStart;
             }
 
-            { // go easy on the CPU
+            { // sleep until an event is pushed, a query completes, or the frame is due
                 const int cyan = 0x00ffff;
                 ZoneScopedNC("sleep time (accuracy check for tracy)", cyan);
-                CORE_ASSERT((m_EngineConfig.m_SleepDuration > 0ms) && (m_EngineConfig.m_SleepDuration <= 256ms),
-                            "sleep duration incorrect");
-                std::this_thread::sleep_for(std::chrono::milliseconds(m_EngineConfig.m_SleepDuration));
+                auto const frameInterval =
+                    app->IsBusy() ? std::chrono::milliseconds(m_EngineConfig.m_SleepDuration) : IDLE_FRAME_INTERVAL;
+                m_WakeupSignal.WaitUntil(frameStart + frameInterval);
             }
         } while (!app->IsFinished());
     }
 
     void Core::Shutdown()
     {
+        // nobody drains the event queue anymore, don't let producers block on it
+        m_EventQueue.Close();
+        m_Events.clear();
+
         if (m_KeyboardInput)
         {
             m_KeyboardInput->Stop();
         }
 
+        m_CurlMulti.Stop();
         CurlWrapper::GlobalCleanup();
 
         if (m_TerminalManager)
@@ -241,5 +283,7 @@ namespace AIAssistant
 
     ThreadPool& Core::GetThreadPool() { return m_ThreadPool; }
 
+    CurlMulti& Core::GetCurlMulti() { return m_CurlMulti; }
+
     TerminalManager* Core::GetTerminalManager() { return m_TerminalManager.get(); }
 } // namespace AIAssistant
\ No newline at end of file
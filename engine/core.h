@@ -20,6 +20,7 @@
    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 #pragma once
+#include <atomic>
 #include <memory>
 
 #include "log/log.h"
@@ -27,6 +28,8 @@
 #include "event/eventQueue.h"
 #include "json/configParser.h"
 #include "auxiliary/threadPool.h"
+#include "auxiliary/wakeupSignal.h"
+#include "curlWrapper/curlMulti.h"
 #include "input/keyboardInput.h"
 
 #include "log/terminalManager.h"
@@ -48,10 +51,13 @@ namespace AIAssistant
         ConfigParser::EngineConfig const& GetConfig() const;
         ConfigParser::EngineConfig::InterfaceType const& GetInterfaceType() const;
         ThreadPool& GetThreadPool();
+        CurlMulti& GetCurlMulti();
         TerminalManager* GetTerminalManager();
 
         // event API
         void PushEvent(EventQueue::EventPtr eventPtr);
+        // wakes up the run loop, e.g. when a query completed
+        void WakeUp();
 
     public:
         static std::unique_ptr<AIAssistant::Log> g_Logger;
@@ -62,11 +68,16 @@ namespace AIAssistant
         void DisableCtrlCOutput();
 
     private:
-        // THREADS_REQUIRED_BY_APP:
-        // file watcher, keyboard input, and web server need threads
-        static constexpr uint THREADS_REQUIRED_BY_APP = 3;
+        // longest sleep of an idle run loop: log lines and periodic tasks still get their turn
+        static constexpr std::chrono::milliseconds IDLE_FRAME_INTERVAL{250};
         ThreadPool m_ThreadPool;
+        CurlMulti m_CurlMulti;
         EventQueue m_EventQueue;
+        std::vector<EventQueue::EventPtr> m_Events; // drained from m_EventQueue each frame, keeps its capacity
+        WakeupSignal m_WakeupSignal;
+        // set by the signal handler, which can't notify m_WakeupSignal: that takes a mutex
+        std::atomic<bool> m_SigIntReceived{false};
+        bool m_SigIntHandled{false}; // main thread only
 
         // core config
         ConfigParser::EngineConfig m_EngineConfig;
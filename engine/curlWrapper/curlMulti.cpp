@@ -0,0 +1,667 @@
+/* Copyright (c) 2025 JC Technolabs
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+#include <algorithm>
+#include <curl/curl.h>
+#include "tracy/Tracy.hpp"
+#include "simdjson/simdjson.h"
+
+#include "core.h"
+#include "engine.h"
+#include "curlWrapper/curlMulti.h"
+
+namespace AIAssistant
+{
+    CurlMulti::~CurlMulti() { Stop(); }
+
+    void CurlMulti::Start(RateLimiter::Limits const& limits, uint reservedInteractiveQueries)
+    {
+        if (m_Running)
+        {
+            return;
+        }
+
+        if (!CurlWrapper::GlobalInit())
+        {
+            LOG_CORE_CRITICAL("curl multi engine not started, all queries will fail");
+            return;
+        }
+
+        m_Multi = curl_multi_init();
+        if (!m_Multi)
+        {
+            LOG_CORE_CRITICAL("curl_multi_init() failed");
+            return;
+        }
+
+        m_MaxConcurrentQueries = limits.m_MaxConcurrency;
+        m_ReservedInteractiveQueries = reservedInteractiveQueries;
+        m_RateLimiter.Reset(limits);
+
+        // multiplex transfers to the same host over one connection where possible,
+        // and keep enough connections cached to serve a full batch without reconnecting
+        curl_multi_setopt(m_Multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+        curl_multi_setopt(m_Multi, CURLMOPT_MAXCONNECTS, static_cast<long>(m_MaxConcurrentQueries));
+
+        curl_version_info_data* versionInfo = curl_version_info(CURLVERSION_NOW);
+        bool http2 = versionInfo && (versionInfo->features & CURL_VERSION_HTTP2);
+        if (http2)
+        {
+            LOG_CORE_INFO("curl multi engine: HTTP/2 multiplexing, up to {} queries in flight", m_MaxConcurrentQueries);
+        }
+        else
+        {
+            LOG_CORE_WARN("curl multi engine: libcurl built without HTTP/2, using HTTP/1.1 keep-alive connections, up to "
+                          "{} queries in flight",
+                          m_MaxConcurrentQueries);
+        }
+
+        m_Running = true;
+        m_LoopTask = Core::g_Core->GetThreadPool().StartService("curl event loop", [this]() { Run(); });
+    }
+
+    void CurlMulti::Stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_PendingMutex);
+            if (!m_Running)
+            {
+                return;
+            }
+            m_Running = false; // Submit() rejects new requests from here on
+        }
+
+        curl_multi_wakeup(m_Multi);
+        if (m_LoopTask.valid())
+        {
+            m_LoopTask.wait(); // wait for graceful exit
+        }
+
+        for (CURL* easy : m_IdleHandles)
+        {
+            curl_easy_cleanup(easy);
+        }
+        m_IdleHandles.clear();
+
+        curl_multi_cleanup(m_Multi);
+        m_Multi = nullptr;
+
+        auto statistics = GetStatistics();
+        LOG_CORE_INFO("curl multi engine stopped ({} queries submitted, {} completed, {} failed, {} retries, {} "
+                      "connections opened)",
+                      statistics.m_Submitted, statistics.m_Completed, statistics.m_Failed, statistics.m_Retries,
+                      statistics.m_NewConnections);
+        for (size_t index = 0; index < NUM_LANES; ++index)
+        {
+            auto lane = static_cast<Lane>(index);
+            auto laneStatistics = GetLaneStatistics(lane);
+            LOG_CORE_INFO("{} lane: {} completed, queue wait p50 {} ms p99 {} ms, latency p50 {} ms p99 {} ms",
+                          GetLaneName(lane), laneStatistics.m_Completed, laneStatistics.m_QueueWaitP50Ms,
+                          laneStatistics.m_QueueWaitP99Ms, laneStatistics.m_LatencyP50Ms, laneStatistics.m_LatencyP99Ms);
+        }
+    }
+
+    std::future<bool> CurlMulti::Submit(CurlWrapper::QueryData const& queryData, CompletionCallback onComplete,
+                                        DataCallback onData, ThreadPool::Priority priority)
+    {
+        auto transfer = CreateTransfer(queryData, std::move(onComplete), std::move(onData), priority);
+        std::future<bool> future = transfer->m_Promise.emplace().get_future();
+        Enqueue(std::move(transfer));
+        return future;
+    }
+
+    void CurlMulti::Post(CurlWrapper::QueryData const& queryData, CompletionCallback onComplete, DataCallback onData,
+                         ThreadPool::Priority priority)
+    {
+        Enqueue(CreateTransfer(queryData, std::move(onComplete), std::move(onData), priority));
+    }
+
+    std::unique_ptr<CurlMulti::Transfer> CurlMulti::CreateTransfer(CurlWrapper::QueryData const& queryData,
+                                                                   CompletionCallback onComplete, DataCallback onData,
+                                                                   ThreadPool::Priority priority)
+    {
+        auto transfer = std::make_unique<Transfer>();
+        transfer->m_QueryData = queryData;
+        transfer->m_BodyReader = RequestBody::Reader(&transfer->m_QueryData.m_Body);
+        transfer->m_OnComplete = std::move(onComplete);
+        transfer->m_OnData = std::move(onData);
+        transfer->m_Priority = priority;
+        transfer->m_SubmitTime = RateLimiter::Clock::now();
+        transfer->m_EstimatedTokens = RateLimiter::EstimateTokens(queryData.m_Body.Size());
+        return transfer;
+    }
+
+    void CurlMulti::Enqueue(std::unique_ptr<Transfer> transfer)
+    {
+        ++m_InFlight;
+
+        if (transfer->m_QueryData.IsValid())
+        {
+            std::lock_guard<std::mutex> lock(m_PendingMutex);
+            if (m_Running)
+            {
+                size_t lane = static_cast<size_t>(transfer->m_Priority);
+                m_Pending[lane].push_back(std::move(transfer));
+                ++m_LaneMetrics[lane].m_Queued;
+                ++m_Submitted;
+                curl_multi_wakeup(m_Multi);
+                return;
+            }
+            LOG_CORE_ERROR("curl multi engine not running, query to {} dropped", transfer->m_QueryData.m_Url);
+        }
+
+        // still completes, so the caller's continuation runs
+        FinishTransfer(std::move(transfer));
+    }
+
+    CurlMulti::Statistics CurlMulti::GetStatistics() const
+    {
+        return Statistics{
+            .m_Submitted = m_Submitted.load(),           //
+            .m_Completed = m_Completed.load(),           //
+            .m_Failed = m_Failed.load(),                 //
+            .m_Retries = m_Retried.load(),               //
+            .m_NewConnections = m_NewConnections.load(), //
+        };
+    }
+
+    CurlMulti::LaneStatistics CurlMulti::GetLaneStatistics(Lane lane) const
+    {
+        LaneMetrics const& metrics = m_LaneMetrics[static_cast<size_t>(lane)];
+        return LaneStatistics{
+            .m_Queued = metrics.m_Queued.load(),                                 //
+            .m_InFlight = metrics.m_InFlight.load(),                             //
+            .m_Completed = metrics.m_Completed.load(),                           //
+            .m_QueueWaitP50Ms = metrics.m_QueueWait.GetPercentileMilliseconds(50), //
+            .m_QueueWaitP99Ms = metrics.m_QueueWait.GetPercentileMilliseconds(99), //
+            .m_LatencyP50Ms = metrics.m_Latency.GetPercentileMilliseconds(50),     //
+            .m_LatencyP99Ms = metrics.m_Latency.GetPercentileMilliseconds(99),     //
+        };
+    }
+
+    char const* CurlMulti::GetLaneName(Lane lane)
+    {
+        switch (lane)
+        {
+            case Lane::Interactive:
+                return "interactive";
+            case Lane::Bulk:
+                return "bulk";
+            default:
+                return "normal";
+        }
+    }
+
+    void CurlMulti::Run()
+    {
+        tracy::SetThreadName("curl event loop");
+
+        while (m_Running)
+        {
+            auto wait = AddPendingTransfers();
+
+            {
+                const int blue = 0x0000ff;
+                ZoneScopedNC("curl_multi_perform", blue);
+                int stillRunning{0};
+                CURLMcode result = curl_multi_perform(m_Multi, &stillRunning);
+                if (result != CURLM_OK)
+                {
+                    LOG_CORE_ERROR("curl_multi_perform() failed: {}", curl_multi_strerror(result));
+                }
+            }
+
+            CompleteTransfers();
+
+            // sleeps until a socket is ready, a timeout expires, or Submit()/Stop() wake us up
+            auto waitMs = std::chrono::duration_cast<std::chrono::milliseconds>(wait).count();
+            auto timeoutMs = std::clamp<int64_t>(waitMs, 1, 1000);
+            CURLMcode result = curl_multi_poll(m_Multi, nullptr, 0, static_cast<int>(timeoutMs), nullptr);
+            if (result != CURLM_OK)
+            {
+                LOG_CORE_ERROR("curl_multi_poll() failed: {}", curl_multi_strerror(result));
+            }
+        }
+
+        AbortTransfers();
+    }
+
+    RateLimiter::Clock::duration CurlMulti::AddPendingTransfers()
+    {
+        auto now = RateLimiter::Clock::now();
+        RateLimiter::Clock::duration wait = 1s;
+
+        while (m_Active.size() < m_RateLimiter.GetConcurrencyLimit())
+        {
+            std::unique_ptr<Transfer> transfer = NextTransfer(now, wait);
+            if (!transfer)
+            {
+                break;
+            }
+
+            if (!SetupTransfer(*transfer))
+            {
+                FinishTransfer(std::move(transfer));
+                continue;
+            }
+
+            CURLMcode result = curl_multi_add_handle(m_Multi, transfer->m_Easy);
+            if (result != CURLM_OK)
+            {
+                LOG_CORE_ERROR("curl_multi_add_handle() failed: {}", curl_multi_strerror(result));
+                ReleaseEasyHandle(transfer->m_Easy);
+                transfer->m_Easy = nullptr;
+                FinishTransfer(std::move(transfer));
+                continue;
+            }
+
+            if (Core::g_Core->Verbose())
+            {
+                LOG_CORE_INFO("sending query ({} in flight)", m_Active.size() + 1);
+            }
+            LaneMetrics& laneMetrics = m_LaneMetrics[static_cast<size_t>(transfer->m_Priority)];
+            ++laneMetrics.m_InFlight;
+            if (!transfer->m_Admitted)
+            {
+                transfer->m_Admitted = true;
+                laneMetrics.m_QueueWait.Record(now - transfer->m_SubmitTime);
+            }
+            CURL* easy = transfer->m_Easy;
+            m_Active[easy] = std::move(transfer);
+        }
+
+        // wake up in time for the next retry
+        for (auto& retry : m_Retries)
+        {
+            wait = std::min(wait, std::max<RateLimiter::Clock::duration>(retry->m_NotBefore - now, 0s));
+        }
+        return wait;
+    }
+
+    bool CurlMulti::CanAdmit(Lane lane) const
+    {
+        if (lane == Lane::Interactive)
+        {
+            return true; // bounded by the concurrency limit only
+        }
+
+        // the rate limiter may have cut concurrency below the reservation, one slot is always shared
+        uint concurrencyLimit = m_RateLimiter.GetConcurrencyLimit();
+        uint reserved = std::min(m_ReservedInteractiveQueries, concurrencyLimit > 0 ? concurrencyLimit - 1 : 0);
+        size_t interactiveInFlight = m_LaneMetrics[static_cast<size_t>(Lane::Interactive)].m_InFlight.load();
+        size_t otherInFlight = m_Active.size() - std::min(interactiveInFlight, m_Active.size());
+        return otherInFlight < concurrencyLimit - reserved;
+    }
+
+    std::unique_ptr<CurlMulti::Transfer> CurlMulti::NextTransfer(RateLimiter::Clock::time_point now,
+                                                                 RateLimiter::Clock::duration& wait)
+    {
+        // lane by lane, most urgent first; within a lane due retries go first, they have been waiting longest
+        std::vector<std::unique_ptr<Transfer>>::iterator retry = m_Retries.end();
+        bool retryDue{false};
+        Transfer* candidate{nullptr};
+        size_t laneIndex{0};
+        for (; laneIndex < NUM_LANES; ++laneIndex)
+        {
+            if (!CanAdmit(static_cast<Lane>(laneIndex)))
+            {
+                return nullptr; // less urgent lanes can't go either
+            }
+
+            for (auto iterator = m_Retries.begin(); iterator != m_Retries.end(); ++iterator)
+            {
+                Transfer const& pendingRetry = **iterator;
+                if ((static_cast<size_t>(pendingRetry.m_Priority) == laneIndex) && (pendingRetry.m_NotBefore <= now) &&
+                    ((retry == m_Retries.end()) || (pendingRetry.m_NotBefore < (*retry)->m_NotBefore)))
+                {
+                    retry = iterator;
+                }
+            }
+            retryDue = (retry != m_Retries.end());
+
+            // only the event loop pops, so the front stays valid after unlocking
+            if (retryDue)
+            {
+                candidate = retry->get();
+            }
+            else
+            {
+                std::lock_guard<std::mutex> lock(m_PendingMutex);
+                if (!m_Pending[laneIndex].empty())
+                {
+                    candidate = m_Pending[laneIndex].front().get();
+                }
+            }
+
+            if (candidate)
+            {
+                break;
+            }
+        }
+
+        if (!candidate)
+        {
+            return nullptr;
+        }
+
+        if (!m_RateLimiter.TryAcquire(candidate->m_EstimatedTokens, now))
+        {
+            wait = std::min(wait, m_RateLimiter.GetWaitTime(candidate->m_EstimatedTokens, now));
+            return nullptr;
+        }
+
+        std::unique_ptr<Transfer> transfer;
+        if (retryDue)
+        {
+            transfer = std::move(*retry);
+            m_Retries.erase(retry);
+        }
+        else
+        {
+            std::lock_guard<std::mutex> lock(m_PendingMutex);
+            transfer = std::move(m_Pending[laneIndex].front());
+            m_Pending[laneIndex].pop_front();
+        }
+        --m_LaneMetrics[laneIndex].m_Queued;
+        return transfer;
+    }
+
+    bool CurlMulti::SetupTransfer(Transfer& transfer)
+    {
+        transfer.m_Easy = AcquireEasyHandle();
+        if (!transfer.m_Easy)
+        {
+            LOG_CORE_CRITICAL("curl_easy_init() failed");
+            return false;
+        }
+
+        if (!transfer.m_Headers.Get()) // kept across retries
+        {
+            transfer.m_Headers.Append("Authorization: Bearer " + CurlWrapper::GetApiKey());
+            transfer.m_Headers.Append("Content-Type: application/json");
+            transfer.m_Headers.Append("Expect:"); // no 100-continue round trip for bodies sent through the read callback
+        }
+
+        // successful bodies go to the data callback if there is one,
+        // error bodies are always buffered for the reply parser
+        auto write_callback = [](void* contents, size_t size, size_t numberOfMembers, void* userPointer) -> size_t
+        {
+            auto* receiving = reinterpret_cast<Transfer*>(userPointer);
+            const size_t totalSize = size * numberOfMembers;
+            auto& response = receiving->m_Response;
+            if (receiving->m_OnData)
+            {
+                if (response.m_HttpStatus == 0)
+                {
+                    curl_easy_getinfo(receiving->m_Easy, CURLINFO_RESPONSE_CODE, &response.m_HttpStatus);
+                }
+                if ((response.m_HttpStatus >= 200) && (response.m_HttpStatus < 300))
+                {
+                    response.m_Streamed = true;
+                    receiving->m_OnData(std::string_view(static_cast<char*>(contents), totalSize));
+                    return totalSize;
+                }
+            }
+
+            // keep SIMDJSON_PADDING spare bytes so the reply parser can iterate the buffer in place
+            size_t required = response.m_Buffer.size() + totalSize + simdjson::SIMDJSON_PADDING;
+            if (response.m_Buffer.capacity() < required)
+            {
+                curl_off_t contentLength{-1};
+                curl_easy_getinfo(receiving->m_Easy, CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, &contentLength);
+                size_t expected = (contentLength > 0) ? static_cast<size_t>(contentLength) + simdjson::SIMDJSON_PADDING : 0;
+                response.m_Buffer.reserve(std::max({required, expected, 2 * response.m_Buffer.capacity()}));
+            }
+            response.m_Buffer.append(static_cast<char*>(contents), totalSize);
+            return totalSize;
+        };
+
+        // collects response headers for the rate limiter, a new status line starts a new response
+        auto header_callback = [](char* contents, size_t size, size_t numberOfMembers, void* userPointer) -> size_t
+        {
+            auto* headers = reinterpret_cast<RateLimiter::Headers*>(userPointer);
+            const size_t totalSize = size * numberOfMembers;
+            std::string_view line(contents, totalSize);
+            if (line.starts_with("HTTP/"))
+            {
+                headers->clear();
+                return totalSize;
+            }
+
+            size_t colon = line.find(':');
+            if (colon != std::string_view::npos)
+            {
+                std::string name(line.substr(0, colon));
+                std::transform(name.begin(), name.end(), name.begin(),
+                               [](unsigned char character) { return std::tolower(character); });
+                std::string_view value = line.substr(colon + 1);
+                size_t first = value.find_first_not_of(" \t");
+                size_t last = value.find_last_not_of(" \t\r\n");
+                (*headers)[name] =
+                    (first == std::string_view::npos) ? "" : std::string(value.substr(first, last - first + 1));
+            }
+            return totalSize;
+        };
+
+        auto& url = transfer.m_QueryData.m_Url;
+
+        CURL* easy = transfer.m_Easy;
+        curl_easy_setopt(easy, CURLOPT_URL, url.c_str());
+        curl_easy_setopt(easy, CURLOPT_HTTPHEADER, transfer.m_Headers.Get());
+        // the body is streamed from its segments, never copied into one buffer
+        transfer.m_BodyReader.Attach(easy);
+        curl_easy_setopt(easy, CURLOPT_WRITEFUNCTION, static_cast<CurlWrapper::CurlWriteCallback>(write_callback));
+        curl_easy_setopt(easy, CURLOPT_WRITEDATA, &transfer);
+        curl_easy_setopt(easy, CURLOPT_HEADERFUNCTION, static_cast<CurlWrapper::CurlHeaderCallback>(header_callback));
+        curl_easy_setopt(easy, CURLOPT_HEADERDATA, &transfer.m_Response.m_Headers);
+        curl_easy_setopt(easy, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+        // wait for a connection that can multiplex rather than opening a new one
+        curl_easy_setopt(easy, CURLOPT_PIPEWAIT, 1L);
+        if (Core::g_Core->Verbose())
+        {
+            curl_easy_setopt(easy, CURLOPT_VERBOSE, 1L);
+            LOG_CORE_INFO("url: {}, data: {}", url, transfer.m_QueryData.m_Body.ToString());
+        }
+        return true;
+    }
+
+    void CurlMulti::CompleteTransfers()
+    {
+        int messagesLeft{0};
+        while (CURLMsg* message = curl_multi_info_read(m_Multi, &messagesLeft))
+        {
+            if (message->msg != CURLMSG_DONE)
+            {
+                continue;
+            }
+
+            CURL* easy = message->easy_handle;
+            CURLcode result = message->data.result;
+
+            auto iterator = m_Active.find(easy);
+            if (iterator == m_Active.end())
+            {
+                LOG_CORE_ERROR("curl multi engine: completion for unknown transfer");
+                continue;
+            }
+            std::unique_ptr<Transfer> transfer = std::move(iterator->second);
+            m_Active.erase(iterator);
+            --m_LaneMetrics[static_cast<size_t>(transfer->m_Priority)].m_InFlight;
+
+            curl_multi_remove_handle(m_Multi, easy);
+
+            long newConnections{0};
+            curl_easy_getinfo(easy, CURLINFO_NUM_CONNECTS, &newConnections);
+            m_NewConnections += static_cast<uint64_t>(newConnections);
+            curl_easy_getinfo(easy, CURLINFO_RESPONSE_CODE, &transfer->m_Response.m_HttpStatus);
+
+            transfer->m_Response.m_Ok = (result == CURLE_OK);
+            if (!transfer->m_Response.m_Ok)
+            {
+                LOG_CORE_ERROR("curl error: {}", curl_easy_strerror(result));
+            }
+
+            ReleaseEasyHandle(easy);
+            transfer->m_Easy = nullptr;
+
+            auto now = RateLimiter::Clock::now();
+            auto& response = transfer->m_Response;
+            m_RateLimiter.OnResponse(response.m_Ok ? response.m_HttpStatus : 0, response.m_Headers, now);
+            if (ScheduleRetry(transfer, now))
+            {
+                continue;
+            }
+
+            // formatting a large body here would hold up every other transfer
+            if (response.m_Ok && !response.m_Streamed && Core::g_Core->Verbose())
+            {
+                LOG_CORE_INFO("Response:\n{}", response.m_Buffer);
+            }
+            FinishTransfer(std::move(transfer));
+        }
+    }
+
+    bool CurlMulti::ScheduleRetry(std::unique_ptr<Transfer>& transfer, RateLimiter::Clock::time_point now)
+    {
+        auto& response = transfer->m_Response;
+        // data already handed out can't be taken back
+        if (!m_Running || response.m_Streamed || !m_RateLimiter.IsRetryable(response.m_Ok, response.m_HttpStatus) ||
+            (transfer->m_Attempt >= m_RateLimiter.GetMaxRetries()))
+        {
+            return false;
+        }
+
+        auto delay = m_RateLimiter.GetRetryDelay(transfer->m_Attempt, response.m_Headers);
+        if (!delay)
+        {
+            LOG_CORE_WARN("query to {} failed (HTTP {}), the server asks to retry too late, giving up",
+                          transfer->m_QueryData.m_Url, response.m_HttpStatus);
+            return false;
+        }
+        ++transfer->m_Attempt;
+        LOG_CORE_WARN("query to {} failed (HTTP {}), retry {} of {} in {} ms", transfer->m_QueryData.m_Url,
+                      response.m_HttpStatus, transfer->m_Attempt, m_RateLimiter.GetMaxRetries(),
+                      std::chrono::duration_cast<std::chrono::milliseconds>(delay.value()).count());
+
+        response = Response{};
+        transfer->m_NotBefore = now + delay.value();
+        ++m_LaneMetrics[static_cast<size_t>(transfer->m_Priority)].m_Queued;
+        m_Retries.push_back(std::move(transfer));
+        ++m_Retried;
+        return true;
+    }
+
+    void CurlMulti::AbortTransfers()
+    {
+        for (auto& [easy, transfer] : m_Active)
+        {
+            curl_multi_remove_handle(m_Multi, easy);
+            ReleaseEasyHandle(easy);
+            transfer->m_Easy = nullptr;
+            --m_LaneMetrics[static_cast<size_t>(transfer->m_Priority)].m_InFlight;
+            FinishTransfer(std::move(transfer));
+        }
+        m_Active.clear();
+
+        for (auto& transfer : m_Retries)
+        {
+            --m_LaneMetrics[static_cast<size_t>(transfer->m_Priority)].m_Queued;
+            FinishTransfer(std::move(transfer));
+        }
+        m_Retries.clear();
+
+        std::array<std::deque<std::unique_ptr<Transfer>>, NUM_LANES> pending;
+        {
+            std::lock_guard<std::mutex> lock(m_PendingMutex);
+            pending.swap(m_Pending);
+        }
+        for (size_t lane = 0; lane < NUM_LANES; ++lane)
+        {
+            for (auto& transfer : pending[lane])
+            {
+                --m_LaneMetrics[lane].m_Queued;
+                FinishTransfer(std::move(transfer));
+            }
+        }
+    }
+
+    void CurlMulti::FinishTransfer(std::unique_ptr<Transfer> transfer)
+    {
+        LaneMetrics& laneMetrics = m_LaneMetrics[static_cast<size_t>(transfer->m_Priority)];
+        ++laneMetrics.m_Completed;
+        laneMetrics.m_Latency.Record(RateLimiter::Clock::now() - transfer->m_SubmitTime);
+
+        if (transfer->m_Response.m_Ok)
+        {
+            ++m_Completed;
+        }
+        else
+        {
+            ++m_Failed;
+        }
+
+        // parsing and writing results happens on the thread pool,
+        // the event loop goes straight back to driving the sockets
+        std::shared_ptr<Transfer> shared = std::move(transfer);
+        Core::g_Core->GetThreadPool().DetachTask(
+            [this, shared]()
+            {
+                bool result = shared->m_Response.m_Ok;
+                try
+                {
+                    if (shared->m_OnComplete)
+                    {
+                        result = shared->m_OnComplete(shared->m_Response);
+                    }
+                }
+                catch (const std::exception& e)
+                {
+                    LOG_CORE_ERROR("Exception in query completion for '{}': {}", shared->m_QueryData.m_Url, e.what());
+                    result = false;
+                }
+                --m_InFlight;
+                if (shared->m_Promise)
+                {
+                    shared->m_Promise->set_value(result);
+                    Core::g_Core->WakeUp(); // the run loop collects the result
+                }
+            },
+            shared->m_Priority);
+    }
+
+    CURL* CurlMulti::AcquireEasyHandle()
+    {
+        if (!m_IdleHandles.empty())
+        {
+            CURL* easy = m_IdleHandles.back();
+            m_IdleHandles.pop_back();
+            return easy;
+        }
+        return curl_easy_init();
+    }
+
+    void CurlMulti::ReleaseEasyHandle(CURL* easy)
+    {
+        // handles are kept for reuse, connections live in the multi handle's cache
+        curl_easy_reset(easy);
+        m_IdleHandles.push_back(easy);
+    }
+} // namespace AIAssistant
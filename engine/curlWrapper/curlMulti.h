@@ -0,0 +1,194 @@
+/* Copyright (c) 2025 JC Technolabs
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "auxiliary/latencyHistogram.h"
+#include "auxiliary/threadPool.h"
+#include "curlWrapper/curlWrapper.h"
+#include "curlWrapper/rateLimiter.h"
+
+typedef void CURLM;
+
+namespace AIAssistant
+{
+    // Asynchronous request engine on top of the curl multi interface.
+    // One event-loop task drives all in-flight transfers. Requests to the
+    // same host share connections, multiplexed over HTTP/2 when libcurl was
+    // built with nghttp2, otherwise reused as HTTP/1.1 keep-alive connections.
+    // Admission goes through a RateLimiter. Failed transfers, 429s and 5xx
+    // responses are retried with backoff before the caller sees them.
+    // Requests wait in one lane per priority and are admitted interactive lane
+    // first; part of the concurrency is reserved for the interactive lane, so
+    // a chat question never queues behind a batch of document chunks.
+    // Completion callbacks run on the thread pool, not on the event loop.
+    class CurlMulti
+    {
+    public:
+        struct Response
+        {
+            bool m_Ok{false}; // transfer succeeded, says nothing about the HTTP status
+            long m_HttpStatus{0};
+            std::string m_Buffer; // body, unless it was handed to a DataCallback; padded for simdjson
+            bool m_Streamed{false};
+            RateLimiter::Headers m_Headers;
+        };
+
+        // returns the result reported through the future of Submit(), ignored by Post()
+        using CompletionCallback = std::function<bool(Response&)>;
+        // receives the body of a 2xx response chunk by chunk, on the event loop: keep it short
+        using DataCallback = std::function<void(std::string_view)>;
+
+        struct Statistics
+        {
+            uint64_t m_Submitted{0};
+            uint64_t m_Completed{0};
+            uint64_t m_Failed{0};
+            uint64_t m_Retries{0};
+            uint64_t m_NewConnections{0};
+        };
+
+        // one lane per thread pool priority
+        using Lane = ThreadPool::Priority;
+        static constexpr size_t NUM_LANES = static_cast<size_t>(Lane::NumPriorities);
+
+        struct LaneStatistics
+        {
+            size_t m_Queued{0}; // waiting for admission, retries included
+            size_t m_InFlight{0};
+            uint64_t m_Completed{0};
+            // submission to admission, and submission to the full response
+            uint64_t m_QueueWaitP50Ms{0};
+            uint64_t m_QueueWaitP99Ms{0};
+            uint64_t m_LatencyP50Ms{0};
+            uint64_t m_LatencyP99Ms{0};
+        };
+
+    public:
+        CurlMulti() = default;
+        ~CurlMulti();
+
+        CurlMulti(CurlMulti const&) = delete;
+        CurlMulti& operator=(CurlMulti const&) = delete;
+
+        // reservedInteractiveQueries: concurrency only the interactive lane may use
+        void Start(RateLimiter::Limits const& limits, uint reservedInteractiveQueries = 0);
+        void Stop();
+
+        // queues a POST request, never blocks on the network;
+        // the priority applies to onComplete, which runs on the thread pool
+        std::future<bool> Submit(CurlWrapper::QueryData const& queryData, CompletionCallback onComplete,
+                                 DataCallback onData = nullptr,
+                                 ThreadPool::Priority priority = ThreadPool::Priority::Normal);
+        // same without a future: onComplete is the continuation and reports the outcome itself,
+        // e.g. by pushing an event, nobody has to poll
+        void Post(CurlWrapper::QueryData const& queryData, CompletionCallback onComplete, DataCallback onData = nullptr,
+                  ThreadPool::Priority priority = ThreadPool::Priority::Normal);
+
+        size_t GetInFlight() const { return m_InFlight; }
+        Statistics GetStatistics() const;
+        LaneStatistics GetLaneStatistics(Lane lane) const;
+        static char const* GetLaneName(Lane lane);
+
+    private:
+        struct Transfer
+        {
+            CURL* m_Easy{nullptr};
+            CurlWrapper::QueryData m_QueryData;
+            RequestBody::Reader m_BodyReader;
+            CurlWrapper::CurlSlist m_Headers;
+            Response m_Response;
+            CompletionCallback m_OnComplete;
+            DataCallback m_OnData;
+            std::optional<std::promise<bool>> m_Promise; // Submit() only
+            ThreadPool::Priority m_Priority{ThreadPool::Priority::Normal};
+            RateLimiter::Clock::time_point m_SubmitTime{};
+            bool m_Admitted{false}; // queue wait is measured up to the first attempt
+            size_t m_EstimatedTokens{0};
+            uint m_Attempt{0};
+            RateLimiter::Clock::time_point m_NotBefore{};
+        };
+
+    private:
+        std::unique_ptr<Transfer> CreateTransfer(CurlWrapper::QueryData const& queryData, CompletionCallback onComplete,
+                                                 DataCallback onData, ThreadPool::Priority priority);
+        void Enqueue(std::unique_ptr<Transfer> transfer);
+        void Run();
+        // returns how long the loop may sleep before admission has to be retried
+        RateLimiter::Clock::duration AddPendingTransfers();
+        std::unique_ptr<Transfer> NextTransfer(RateLimiter::Clock::time_point now, RateLimiter::Clock::duration& wait);
+        bool CanAdmit(Lane lane) const;
+        bool ScheduleRetry(std::unique_ptr<Transfer>& transfer, RateLimiter::Clock::time_point now);
+        void CompleteTransfers();
+        void AbortTransfers();
+        bool SetupTransfer(Transfer& transfer);
+        void FinishTransfer(std::unique_ptr<Transfer> transfer);
+        CURL* AcquireEasyHandle();
+        void ReleaseEasyHandle(CURL* easy);
+
+    private:
+        CURLM* m_Multi{nullptr};
+        uint m_MaxConcurrentQueries{0};
+        uint m_ReservedInteractiveQueries{0};
+        std::atomic<bool> m_Running{false};
+        std::future<void> m_LoopTask;
+
+        // filled by Submit(), drained by the event loop
+        std::mutex m_PendingMutex;
+        std::array<std::deque<std::unique_ptr<Transfer>>, NUM_LANES> m_Pending;
+        std::atomic<size_t> m_InFlight{0};
+
+        // only accessed by the event loop
+        std::unordered_map<CURL*, std::unique_ptr<Transfer>> m_Active;
+        std::vector<std::unique_ptr<Transfer>> m_Retries;
+        std::vector<CURL*> m_IdleHandles;
+        RateLimiter m_RateLimiter;
+
+        std::atomic<uint64_t> m_Submitted{0};
+        std::atomic<uint64_t> m_Completed{0};
+        std::atomic<uint64_t> m_Failed{0};
+        std::atomic<uint64_t> m_Retried{0};
+        std::atomic<uint64_t> m_NewConnections{0};
+
+        struct LaneMetrics
+        {
+            std::atomic<size_t> m_Queued{0};
+            std::atomic<size_t> m_InFlight{0};
+            std::atomic<uint64_t> m_Completed{0};
+            LatencyHistogram m_QueueWait;
+            LatencyHistogram m_Latency;
+        };
+        std::array<LaneMetrics, NUM_LANES> m_LaneMetrics;
+    };
+} // namespace AIAssistant
@@ -36,37 +36,9 @@ namespace AIAssistant
     CurlWrapper::CurlWrapper()
     {
         // once globally
+        if (!GlobalInit())
         {
-            static bool initialized{false};
-            static std::mutex initMutex;
-
-            std::lock_guard<std::mutex> lock(initMutex);
-            if (!initialized)
-            {
-                char* apiKeyEnv = std::getenv("OPENAI_API_KEY");
-                if (apiKeyEnv)
-                {
-                    m_ApiKey = std::string(apiKeyEnv);
-                } // if it is null, this will be caught in IsValidKey()
-
-                if (!IsValidKey(m_ApiKey))
-                {
-                    LOG_CORE_CRITICAL("Missing OPENAI_API_KEY env variable");
-                    return;
-                }
-
-                CURLcode res = curl_global_init(CURL_GLOBAL_DEFAULT);
-                if (res != CURLE_OK)
-                {
-                    LOG_CORE_CRITICAL("curl_global_init() failed: {}", curl_easy_strerror(res));
-                    return;
-                }
-                else
-                {
-                    initialized = true;
-                    LOG_CORE_INFO("libcurl globally initialized");
-                }
-            }
+            return;
         }
 
         // per instance
@@ -103,6 +75,43 @@ namespace AIAssistant
         }
     }
 
+    bool CurlWrapper::GlobalInit()
+    {
+        static bool initialized{false};
+        static std::mutex initMutex;
+
+        std::lock_guard<std::mutex> lock(initMutex);
+        if (!initialized)
+        {
+            char* apiKeyEnv = std::getenv("OPENAI_API_KEY");
+            if (apiKeyEnv)
+            {
+                m_ApiKey = std::string(apiKeyEnv);
+            } // if it is null, this will be caught in IsValidKey()
+
+            if (!IsValidKey(m_ApiKey))
+            {
+                LOG_CORE_CRITICAL("Missing OPENAI_API_KEY env variable");
+                return false;
+            }
+
+            CURLcode res = curl_global_init(CURL_GLOBAL_DEFAULT);
+            if (res != CURLE_OK)
+            {
+                LOG_CORE_CRITICAL("curl_global_init() failed: {}", curl_easy_strerror(res));
+                return false;
+            }
+            else
+            {
+                initialized = true;
+                LOG_CORE_INFO("libcurl globally initialized");
+            }
+        }
+        return initialized;
+    }
+
+    std::string const& CurlWrapper::GetApiKey() { return m_ApiKey; }
+
     void CurlWrapper::GlobalCleanup()
     {
         curl_global_cleanup();
@@ -131,7 +140,7 @@ namespace AIAssistant
     bool CurlWrapper::QueryData::IsValid() const
     {
         bool urlEmpty = m_Url.empty();
-        bool dataEmpty = m_Data.empty();
+        bool dataEmpty = m_Body.Empty();
 
         if (urlEmpty)
         {
@@ -155,9 +164,10 @@ namespace AIAssistant
         CurlSlist headers;
         headers.Append("Authorization: Bearer " + m_ApiKey);
         headers.Append("Content-Type: application/json");
+        headers.Append("Expect:"); // no 100-continue round trip for bodies sent through the read callback
 
         auto& url = queryData.m_Url;
-        auto& data = queryData.m_Data;
+        RequestBody::Reader bodyReader(&queryData.m_Body);
 
         // lambda for write callback
         auto write_callback = [](void* contents, size_t size, size_t numberOfMembers, void* userPointer) -> size_t
@@ -170,13 +180,13 @@ namespace AIAssistant
 
         curl_easy_setopt(m_Curl, CURLOPT_URL, url.c_str());
         curl_easy_setopt(m_Curl, CURLOPT_HTTPHEADER, headers.Get());
-        curl_easy_setopt(m_Curl, CURLOPT_POSTFIELDS, data.c_str());
+        bodyReader.Attach(m_Curl);
         curl_easy_setopt(m_Curl, CURLOPT_WRITEFUNCTION, static_cast<CurlWriteCallback>(write_callback));
         curl_easy_setopt(m_Curl, CURLOPT_WRITEDATA, &m_ReadBuffer);
         if (Core::g_Core->Verbose())
         {
             curl_easy_setopt(m_Curl, CURLOPT_VERBOSE, 1L);
-            LOG_CORE_INFO("url: {}, data: {}", url, data);
+            LOG_CORE_INFO("url: {}, data: {}", url, queryData.m_Body.ToString());
         }
 
         LOG_CORE_INFO("sending query {}", ++m_QueryCounter);
@@ -23,7 +23,8 @@
 
 #include <string>
 
-typedef void CURL;
+#include "curlWrapper/requestBody.h"
+
 struct curl_slist;
 
 namespace AIAssistant
@@ -34,12 +35,13 @@ namespace AIAssistant
         struct QueryData
         {
             std::string m_Url;
-            std::string m_Data;
+            RequestBody m_Body;
             bool IsValid() const;
         };
 
         // type alias for curl write callback
         using CurlWriteCallback = size_t (*)(void*, size_t, size_t, void*);
+        using CurlHeaderCallback = size_t (*)(char*, size_t, size_t, void*);
 
         // RAII for curl_slist
         class CurlSlist
@@ -72,10 +74,13 @@ namespace AIAssistant
         std::string& GetBuffer();
         void Clear();
 
+        // reads the API key and initializes libcurl, once
+        static bool GlobalInit();
         static void GlobalCleanup();
+        static std::string const& GetApiKey();
 
     private:
-        bool IsValidKey(std::string const& key);
+        static bool IsValidKey(std::string const& key);
 
     private:
         static std::string m_ApiKey;
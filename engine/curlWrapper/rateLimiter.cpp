@@ -0,0 +1,292 @@
+/* Copyright (c) 2025 JC Technolabs
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+
+#include "engine.h"
+#include "curlWrapper/rateLimiter.h"
+
+namespace AIAssistant
+{
+    namespace
+    {
+        constexpr auto BACKOFF_BASE = 500ms;
+        constexpr auto BACKOFF_CAP = 60s;
+        // several 429s from one burst count as one congestion signal
+        constexpr auto DECREASE_HOLD_OFF = 1s;
+
+        std::chrono::duration<double> ToSeconds(double seconds) { return std::chrono::duration<double>(seconds); }
+    } // namespace
+
+    void RateLimiter::Reset(Limits const& limits)
+    {
+        auto now = Clock::now();
+        m_Limits = limits;
+        m_Requests.SetPerMinute(limits.m_RequestsPerMinute, now);
+        m_Requests.m_Level = m_Requests.m_Capacity;
+        m_Tokens.SetPerMinute(limits.m_TokensPerMinute, now);
+        m_Tokens.m_Level = m_Tokens.m_Capacity;
+        m_ConcurrencyWindow = static_cast<double>(std::max(limits.m_MaxConcurrency, 1u));
+        m_LastDecrease = {};
+    }
+
+    bool RateLimiter::TryAcquire(size_t estimatedTokens, Clock::time_point now)
+    {
+        m_Requests.Refill(now);
+        m_Tokens.Refill(now);
+
+        double tokens = static_cast<double>(estimatedTokens);
+        if (!m_Requests.HasEnough(1.0) || !m_Tokens.HasEnough(tokens))
+        {
+            return false;
+        }
+
+        m_Requests.Take(1.0);
+        m_Tokens.Take(tokens);
+        return true;
+    }
+
+    RateLimiter::Clock::duration RateLimiter::GetWaitTime(size_t estimatedTokens, Clock::time_point now)
+    {
+        m_Requests.Refill(now);
+        m_Tokens.Refill(now);
+        return std::max(m_Requests.GetWaitTime(1.0), m_Tokens.GetWaitTime(static_cast<double>(estimatedTokens)));
+    }
+
+    uint RateLimiter::GetConcurrencyLimit() const { return static_cast<uint>(m_ConcurrencyWindow); }
+
+    void RateLimiter::OnResponse(long httpStatus, Headers const& headers, Clock::time_point now)
+    {
+        SyncBucket(m_Requests, headers, "x-ratelimit-limit-requests", "x-ratelimit-remaining-requests",
+                   "x-ratelimit-reset-requests", now);
+        SyncBucket(m_Tokens, headers, "x-ratelimit-limit-tokens", "x-ratelimit-remaining-tokens",
+                   "x-ratelimit-reset-tokens", now);
+
+        double maxConcurrency = static_cast<double>(std::max(m_Limits.m_MaxConcurrency, 1u));
+        if ((httpStatus == 429) || (httpStatus == 503))
+        {
+            if (now - m_LastDecrease >= DECREASE_HOLD_OFF)
+            {
+                m_ConcurrencyWindow = std::max(1.0, m_ConcurrencyWindow / 2.0);
+                m_LastDecrease = now;
+                LOG_CORE_WARN("rate limited (HTTP {}), concurrency reduced to {}", httpStatus, GetConcurrencyLimit());
+            }
+        }
+        else if ((httpStatus >= 200) && (httpStatus < 300))
+        {
+            // one full window of successes grows the window by one
+            m_ConcurrencyWindow = std::min(maxConcurrency, m_ConcurrencyWindow + 1.0 / m_ConcurrencyWindow);
+        }
+    }
+
+    bool RateLimiter::IsRetryable(bool transferOk, long httpStatus) const
+    {
+        if (!transferOk)
+        {
+            return true; // connection reset, timeout, ...
+        }
+        return (httpStatus == 429) || (httpStatus == 500) || (httpStatus == 502) || (httpStatus == 503) ||
+               (httpStatus == 504);
+    }
+
+    std::optional<RateLimiter::Clock::duration> RateLimiter::GetRetryDelay(uint attempt, Headers const& headers)
+    {
+        // compared as double before the cast, a huge value would overflow it
+        auto serverDelay = [](double seconds) -> std::optional<Clock::duration>
+        {
+            if (seconds > std::chrono::duration<double>(BACKOFF_CAP).count())
+            {
+                return std::nullopt;
+            }
+            return std::chrono::duration_cast<Clock::duration>(ToSeconds(seconds));
+        };
+
+        // non-standard, but sent by OpenAI with millisecond precision
+        auto retryAfterMs = headers.find("retry-after-ms");
+        if (retryAfterMs != headers.end())
+        {
+            double milliseconds = std::atof(retryAfterMs->second.c_str());
+            if (milliseconds > 0.0)
+            {
+                return serverDelay(milliseconds / 1000.0);
+            }
+        }
+
+        // only the delta-seconds form, an HTTP date falls back to backoff
+        auto retryAfter = headers.find("retry-after");
+        if (retryAfter != headers.end())
+        {
+            double seconds = std::atof(retryAfter->second.c_str());
+            if (seconds > 0.0)
+            {
+                return serverDelay(seconds);
+            }
+        }
+
+        // equal jitter: half the exponential delay fixed, the other half random
+        auto exponential = std::min<Clock::duration>(BACKOFF_CAP, BACKOFF_BASE * (1ull << std::min(attempt, 16u)));
+        std::uniform_int_distribution<Clock::rep> jitter(0, exponential.count() / 2);
+        return exponential / 2 + Clock::duration(jitter(m_Random));
+    }
+
+    RateLimiter::Clock::duration RateLimiter::ParseDuration(std::string_view text)
+    {
+        double seconds{0.0};
+        size_t position{0};
+        while (position < text.size())
+        {
+            size_t numberEnd = position;
+            while ((numberEnd < text.size()) && (std::isdigit(static_cast<unsigned char>(text[numberEnd])) ||
+                                                 (text[numberEnd] == '.')))
+            {
+                ++numberEnd;
+            }
+            if (numberEnd == position)
+            {
+                break; // not a duration
+            }
+            double value = std::atof(std::string(text.substr(position, numberEnd - position)).c_str());
+
+            size_t unitEnd = numberEnd;
+            while ((unitEnd < text.size()) && std::isalpha(static_cast<unsigned char>(text[unitEnd])))
+            {
+                ++unitEnd;
+            }
+            std::string_view unit = text.substr(numberEnd, unitEnd - numberEnd);
+
+            if (unit == "ms")
+            {
+                seconds += value / 1000.0;
+            }
+            else if (unit == "s" || unit.empty())
+            {
+                seconds += value;
+            }
+            else if (unit == "m")
+            {
+                seconds += value * 60.0;
+            }
+            else if (unit == "h")
+            {
+                seconds += value * 3600.0;
+            }
+            position = unitEnd;
+        }
+        return std::chrono::duration_cast<Clock::duration>(ToSeconds(seconds));
+    }
+
+    void RateLimiter::SyncBucket(Bucket& bucket, Headers const& headers, std::string const& limitHeader,
+                                 std::string const& remainingHeader, std::string const& resetHeader,
+                                 Clock::time_point now)
+    {
+        auto limit = headers.find(limitHeader);
+        if (limit != headers.end())
+        {
+            double perMinute = std::atof(limit->second.c_str());
+            if ((perMinute > 0.0) && (perMinute != bucket.m_Capacity))
+            {
+                LOG_CORE_INFO("rate limit from server: {} = {}", limitHeader, perMinute);
+                bucket.SetPerMinute(perMinute, now);
+            }
+        }
+
+        auto remaining = headers.find(remainingHeader);
+        if (remaining != headers.end())
+        {
+            bucket.Refill(now);
+            // the server's view wins if it has less left than we think
+            double serverLevel = std::atof(remaining->second.c_str());
+            bucket.m_Level = std::min(bucket.m_Level, serverLevel);
+        }
+
+        // time until the server's bucket is full again: refill at the rate that gets there on time,
+        // back to the nominal rate once full (Refill)
+        auto reset = headers.find(resetHeader);
+        if ((reset != headers.end()) && !bucket.IsUnlimited() && (bucket.m_Level < bucket.m_Capacity))
+        {
+            double seconds = std::chrono::duration<double>(ParseDuration(reset->second)).count();
+            if (seconds > 0.0)
+            {
+                bucket.Refill(now);
+                bucket.m_RefillPerSecond = (bucket.m_Capacity - bucket.m_Level) / seconds;
+            }
+        }
+    }
+
+    void RateLimiter::Bucket::SetPerMinute(double perMinute, Clock::time_point now)
+    {
+        Refill(now);
+        // an unlimited bucket is never drawn from, it starts full; "remaining" headers adjust it
+        m_Level = IsUnlimited() ? perMinute : std::min(m_Level, perMinute);
+        m_Capacity = perMinute;
+        m_RefillPerSecond = perMinute / 60.0;
+        m_LastRefill = now;
+    }
+
+    void RateLimiter::Bucket::Refill(Clock::time_point now)
+    {
+        if (now <= m_LastRefill)
+        {
+            return;
+        }
+        double elapsed = std::chrono::duration<double>(now - m_LastRefill).count();
+        m_Level = std::min(m_Capacity, m_Level + elapsed * m_RefillPerSecond);
+        m_LastRefill = now;
+        if (!IsUnlimited() && (m_Level >= m_Capacity))
+        {
+            m_RefillPerSecond = m_Capacity / 60.0; // a reset period only applies to the window it was sent for
+        }
+    }
+
+    bool RateLimiter::Bucket::IsUnlimited() const { return m_Capacity <= 0.0; }
+
+    bool RateLimiter::Bucket::HasEnough(double amount) const
+    {
+        if (IsUnlimited())
+        {
+            return true;
+        }
+        // requests larger than the bucket pass once it is full
+        return m_Level >= std::min(amount, m_Capacity);
+    }
+
+    void RateLimiter::Bucket::Take(double amount)
+    {
+        // an unlimited bucket must not go negative, it would block once the server reports a limit
+        if (IsUnlimited())
+        {
+            return;
+        }
+        m_Level -= std::min(amount, m_Capacity);
+    }
+
+    RateLimiter::Clock::duration RateLimiter::Bucket::GetWaitTime(double amount) const
+    {
+        double missing = std::min(amount, m_Capacity) - m_Level;
+        if (IsUnlimited() || (missing <= 0.0) || (m_RefillPerSecond <= 0.0))
+        {
+            return Clock::duration::zero();
+        }
+        return std::chrono::duration_cast<Clock::duration>(ToSeconds(missing / m_RefillPerSecond));
+    }
+} // namespace AIAssistant
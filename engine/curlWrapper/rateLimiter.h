@@ -0,0 +1,108 @@
+/* Copyright (c) 2025 JC Technolabs
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+#pragma once
+
+#include <chrono>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace AIAssistant
+{
+    // Global admission control for API requests, shared by all sessions.
+    // Two token buckets track requests and estimated prompt tokens per
+    // minute (a limit of 0 means unlimited until the server reports one).
+    // Their limits and levels follow the provider's x-ratelimit-* headers,
+    // the reset periods set how fast a drained bucket refills.
+    // The number of transfers in flight is adjusted AIMD style: +1 per
+    // window of successful responses, halved on 429/503.
+    // Not thread-safe, owned by the curl event loop.
+    class RateLimiter
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+        using Headers = std::unordered_map<std::string, std::string>; // lower-case names
+
+        struct Limits
+        {
+            double m_RequestsPerMinute{0.0};
+            double m_TokensPerMinute{0.0};
+            uint m_MaxConcurrency{1};
+            uint m_MaxRetries{0};
+        };
+
+    public:
+        void Reset(Limits const& limits);
+
+        // takes one request and the estimated tokens from the buckets if both have enough
+        bool TryAcquire(size_t estimatedTokens, Clock::time_point now);
+        // time until TryAcquire() could succeed
+        Clock::duration GetWaitTime(size_t estimatedTokens, Clock::time_point now);
+        uint GetConcurrencyLimit() const;
+
+        // updates buckets and concurrency from a finished transfer (httpStatus 0: network error)
+        void OnResponse(long httpStatus, Headers const& headers, Clock::time_point now);
+
+        bool IsRetryable(bool transferOk, long httpStatus) const;
+        uint GetMaxRetries() const { return m_Limits.m_MaxRetries; }
+        // Retry-After if the server sent one, jittered exponential backoff otherwise;
+        // nullopt if the server asks for longer than the backoff cap: not worth waiting for
+        std::optional<Clock::duration> GetRetryDelay(uint attempt, Headers const& headers);
+
+        // rough prompt size, about four bytes of JSON per token
+        static size_t EstimateTokens(size_t requestSize) { return requestSize / 4 + 1; }
+
+        // parses reset periods as sent by OpenAI, e.g. "20ms", "1s", "6m0s"
+        static Clock::duration ParseDuration(std::string_view text);
+
+    private:
+        struct Bucket
+        {
+            double m_Capacity{0.0};
+            double m_Level{0.0};
+            double m_RefillPerSecond{0.0}; // capacity per minute, or what the server's reset period implies
+            Clock::time_point m_LastRefill{};
+
+            void SetPerMinute(double perMinute, Clock::time_point now);
+            void Refill(Clock::time_point now);
+            bool IsUnlimited() const; // no limit configured or reported yet
+            bool HasEnough(double amount) const;
+            void Take(double amount);
+            Clock::duration GetWaitTime(double amount) const;
+        };
+
+        void SyncBucket(Bucket& bucket, Headers const& headers, std::string const& limitHeader,
+                        std::string const& remainingHeader, std::string const& resetHeader, Clock::time_point now);
+
+    private:
+        Limits m_Limits;
+        Bucket m_Requests;
+        Bucket m_Tokens;
+
+        double m_ConcurrencyWindow{1.0};
+        Clock::time_point m_LastDecrease{};
+
+        std::mt19937 m_Random{std::random_device{}()};
+    };
+} // namespace AIAssistant
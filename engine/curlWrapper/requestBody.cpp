@@ -0,0 +1,135 @@
+/* Copyright (c) 2025 JC Technolabs
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+#include <algorithm>
+#include <cstring>
+#include <curl/curl.h>
+
+#include "curlWrapper/requestBody.h"
+
+namespace AIAssistant
+{
+    void RequestBody::Append(std::string text)
+    {
+        if (text.empty())
+        {
+            return;
+        }
+        Append(std::make_shared<std::string const>(std::move(text)));
+    }
+
+    void RequestBody::Append(Segment const& segment)
+    {
+        if (!segment || segment->empty())
+        {
+            return;
+        }
+        m_Size += segment->size();
+        m_Segments.push_back(segment);
+    }
+
+    std::string RequestBody::ToString() const
+    {
+        std::string text;
+        text.reserve(m_Size);
+        for (auto const& segment : m_Segments)
+        {
+            text += *segment;
+        }
+        return text;
+    }
+
+    void RequestBody::Reader::Attach(CURL* easy)
+    {
+        auto readCallback = [](char* buffer, size_t size, size_t numberOfItems, void* userPointer) -> size_t
+        { return static_cast<Reader*>(userPointer)->Read(buffer, size * numberOfItems); };
+
+        // curl rewinds the body when it has to send it again, e.g. after a redirect
+        auto seekCallback = [](void* userPointer, curl_off_t offset, int origin) -> int
+        {
+            if ((origin != SEEK_SET) || (offset < 0))
+            {
+                return CURL_SEEKFUNC_CANTSEEK;
+            }
+            return static_cast<Reader*>(userPointer)->Seek(static_cast<size_t>(offset)) ? CURL_SEEKFUNC_OK
+                                                                                        : CURL_SEEKFUNC_FAIL;
+        };
+
+        Seek(0);
+        curl_off_t size = m_Body ? static_cast<curl_off_t>(m_Body->Size()) : 0;
+
+        curl_easy_setopt(easy, CURLOPT_POST, 1L);
+        curl_easy_setopt(easy, CURLOPT_POSTFIELDS, nullptr);
+        curl_easy_setopt(easy, CURLOPT_POSTFIELDSIZE_LARGE, size);
+        curl_easy_setopt(easy, CURLOPT_READFUNCTION, static_cast<curl_read_callback>(readCallback));
+        curl_easy_setopt(easy, CURLOPT_READDATA, this);
+        curl_easy_setopt(easy, CURLOPT_SEEKFUNCTION, static_cast<curl_seek_callback>(seekCallback));
+        curl_easy_setopt(easy, CURLOPT_SEEKDATA, this);
+    }
+
+    size_t RequestBody::Reader::Read(char* buffer, size_t size)
+    {
+        if (!m_Body)
+        {
+            return 0;
+        }
+
+        auto const& segments = m_Body->m_Segments;
+        size_t copied{0};
+        while ((copied < size) && (m_Segment < segments.size()))
+        {
+            std::string const& segment = *segments[m_Segment];
+            size_t count = std::min(size - copied, segment.size() - m_Offset);
+            std::memcpy(buffer + copied, segment.data() + m_Offset, count);
+            copied += count;
+            m_Offset += count;
+            if (m_Offset == segment.size())
+            {
+                ++m_Segment;
+                m_Offset = 0;
+            }
+        }
+        return copied;
+    }
+
+    bool RequestBody::Reader::Seek(size_t offset)
+    {
+        m_Segment = 0;
+        m_Offset = 0;
+        if (!m_Body)
+        {
+            return offset == 0;
+        }
+        if (offset > m_Body->Size())
+        {
+            return false;
+        }
+
+        auto const& segments = m_Body->m_Segments;
+        while ((m_Segment < segments.size()) && (offset >= segments[m_Segment]->size()))
+        {
+            offset -= segments[m_Segment]->size();
+            ++m_Segment;
+        }
+        m_Offset = offset;
+        return true;
+    }
+} // namespace AIAssistant
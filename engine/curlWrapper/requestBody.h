@@ -0,0 +1,72 @@
+/* Copyright (c) 2025 JC Technolabs
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+typedef void CURL;
+
+namespace AIAssistant
+{
+    // POST body made of segments that are never concatenated into one string.
+    // Large parts shared by many requests (the escaped environment) are referenced,
+    // not copied; curl pulls the bytes segment by segment through a read callback.
+    class RequestBody
+    {
+    public:
+        using Segment = std::shared_ptr<std::string const>;
+
+        // feeds a body to one curl transfer, each transfer needs its own reader
+        class Reader
+        {
+        public:
+            explicit Reader(RequestBody const* body = nullptr) : m_Body(body) {}
+
+            // sets up CURLOPT_POST, size, read and seek callbacks and rewinds
+            void Attach(CURL* easy);
+            size_t Read(char* buffer, size_t size);
+            bool Seek(size_t offset);
+
+        private:
+            RequestBody const* m_Body;
+            size_t m_Segment{0};
+            size_t m_Offset{0}; // within m_Segment
+        };
+
+    public:
+        void Append(std::string text);
+        void Append(Segment const& segment);
+
+        size_t Size() const { return m_Size; }
+        bool Empty() const { return m_Size == 0; }
+        std::vector<Segment> const& GetSegments() const { return m_Segments; }
+
+        // materializes the body, for logging only
+        std::string ToString() const;
+
+    private:
+        std::vector<Segment> m_Segments;
+        size_t m_Size{0};
+    };
+} // namespace AIAssistant
@@ -0,0 +1,97 @@
+/* Copyright (c) 2025 JC Technolabs
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+#include "curlWrapper/sseParser.h"
+
+namespace AIAssistant
+{
+    void SseParser::Feed(std::string_view chunk, EventCallback const& onEvent)
+    {
+        size_t position{0};
+        while (position < chunk.size())
+        {
+            size_t lineEnd = chunk.find('\n', position);
+            if (lineEnd == std::string_view::npos)
+            {
+                m_Line.append(chunk.substr(position));
+                return;
+            }
+
+            std::string_view line = chunk.substr(position, lineEnd - position);
+            if (!m_Line.empty())
+            {
+                m_Line.append(line);
+                line = m_Line;
+            }
+            if (!line.empty() && (line.back() == '\r'))
+            {
+                line.remove_suffix(1);
+            }
+
+            ProcessLine(line, onEvent);
+            m_Line.clear();
+            position = lineEnd + 1;
+        }
+    }
+
+    void SseParser::ProcessLine(std::string_view line, EventCallback const& onEvent)
+    {
+        // a blank line dispatches the event
+        if (line.empty())
+        {
+            if (m_HasData)
+            {
+                onEvent(m_Event);
+            }
+            m_Event = {};
+            m_HasData = false;
+            return;
+        }
+
+        if (line.front() == ':')
+        {
+            return; // comment, used as keep-alive
+        }
+
+        size_t colon = line.find(':');
+        std::string_view field = line.substr(0, colon);
+        std::string_view value = (colon == std::string_view::npos) ? std::string_view{} : line.substr(colon + 1);
+        if (!value.empty() && (value.front() == ' '))
+        {
+            value.remove_prefix(1);
+        }
+
+        if (field == "data")
+        {
+            if (m_HasData)
+            {
+                m_Event.m_Data += '\n';
+            }
+            m_Event.m_Data.append(value);
+            m_HasData = true;
+        }
+        else if (field == "event")
+        {
+            m_Event.m_Event = value;
+        }
+        // "id" and "retry" are not used by the LLM APIs
+    }
+} // namespace AIAssistant
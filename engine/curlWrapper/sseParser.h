@@ -0,0 +1,55 @@
+/* Copyright (c) 2025 JC Technolabs
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace AIAssistant
+{
+    // Incremental parser for text/event-stream bodies (server-sent events).
+    // Chunks can be fed exactly as they arrive from the network; a line or
+    // an event may be split across any number of chunks.
+    class SseParser
+    {
+    public:
+        struct Event
+        {
+            std::string m_Event; // "event:" field, empty for unnamed events
+            std::string m_Data;  // "data:" fields, joined by '\n'
+        };
+
+        using EventCallback = std::function<void(Event const&)>;
+
+    public:
+        void Feed(std::string_view chunk, EventCallback const& onEvent);
+
+    private:
+        void ProcessLine(std::string_view line, EventCallback const& onEvent);
+
+    private:
+        std::string m_Line; // incomplete line from the previous chunk
+        Event m_Event;
+        bool m_HasData{false};
+    };
+} // namespace AIAssistant
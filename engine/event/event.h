@@ -43,7 +43,8 @@ namespace AIAssistant
         FileModified,        //
         AppError,            //
         EngineEvent,         //
-        PythonCrashed        //
+        PythonCrashed,       //
+        QueryCompleted       //
     };
 
     enum EventCategory
@@ -0,0 +1,78 @@
+/* Copyright (c) 2025 JC Technolabs
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+#include "event/eventPool.h"
+
+namespace AIAssistant
+{
+    EventPool& EventPool::Get()
+    {
+        static EventPool instance;
+        return instance;
+    }
+
+    void* EventPool::Allocate(size_t size)
+    {
+        size_t const index = GetSizeClassIndex(size);
+        if (index >= NUM_SIZE_CLASSES)
+        {
+            return ::operator new(size);
+        }
+
+        SizeClass& sizeClass = m_SizeClasses[index];
+        std::lock_guard<std::mutex> guard(sizeClass.m_Mutex);
+        if (!sizeClass.m_FreeList)
+        {
+            AddChunk(sizeClass, (index + 1) * SIZE_CLASS_GRANULARITY);
+        }
+        FreeBlock* block = sizeClass.m_FreeList;
+        sizeClass.m_FreeList = block->m_Next;
+        return block;
+    }
+
+    void EventPool::Deallocate(void* pointer, size_t size)
+    {
+        size_t const index = GetSizeClassIndex(size);
+        if (index >= NUM_SIZE_CLASSES)
+        {
+            ::operator delete(pointer);
+            return;
+        }
+
+        SizeClass& sizeClass = m_SizeClasses[index];
+        std::lock_guard<std::mutex> guard(sizeClass.m_Mutex);
+        FreeBlock* block = static_cast<FreeBlock*>(pointer);
+        block->m_Next = sizeClass.m_FreeList;
+        sizeClass.m_FreeList = block;
+    }
+
+    void EventPool::AddChunk(SizeClass& sizeClass, size_t blockSize)
+    {
+        // new[] aligns to max_align_t, every block size is a multiple of it
+        auto& chunk = sizeClass.m_Chunks.emplace_back(std::make_unique<std::byte[]>(blockSize * BLOCKS_PER_CHUNK));
+        for (size_t blockIndex = BLOCKS_PER_CHUNK; blockIndex > 0; --blockIndex)
+        {
+            FreeBlock* block = reinterpret_cast<FreeBlock*>(chunk.get() + (blockIndex - 1) * blockSize);
+            block->m_Next = sizeClass.m_FreeList;
+            sizeClass.m_FreeList = block;
+        }
+    }
+} // namespace AIAssistant
@@ -0,0 +1,103 @@
+/* Copyright (c) 2025 JC Technolabs
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+#pragma once
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace AIAssistant
+{
+    // Recycles the memory of events. EventPool::Create<T>() allocates the event and its
+    // shared_ptr control block in one block taken from a free list, and the block goes back
+    // to that list when the last reference is dropped, on whatever thread that happens.
+    // The free lists only grow, chunk by chunk, to the peak number of live events.
+    class EventPool
+    {
+    public:
+        template <typename T>
+        class Allocator
+        {
+        public:
+            using value_type = T;
+
+            Allocator() = default;
+            template <typename U>
+            Allocator(Allocator<U> const&)
+            {
+            }
+
+            T* allocate(size_t count) { return static_cast<T*>(EventPool::Get().Allocate(count * sizeof(T))); }
+            void deallocate(T* pointer, size_t count) { EventPool::Get().Deallocate(pointer, count * sizeof(T)); }
+
+            template <typename U>
+            bool operator==(Allocator<U> const&) const
+            {
+                return true;
+            }
+        };
+
+    public:
+        static EventPool& Get();
+
+        template <typename EventType, typename... Args>
+        static std::shared_ptr<EventType> Create(Args&&... args)
+        {
+            static_assert(alignof(EventType) <= alignof(std::max_align_t), "over-aligned events are not pooled");
+            return std::allocate_shared<EventType>(Allocator<EventType>(), std::forward<Args>(args)...);
+        }
+
+        void* Allocate(size_t size);
+        void Deallocate(void* pointer, size_t size);
+
+    private:
+        EventPool() = default;
+        ~EventPool() = default;
+
+        EventPool(EventPool const&) = delete;
+        EventPool& operator=(EventPool const&) = delete;
+
+    private:
+        static constexpr size_t SIZE_CLASS_GRANULARITY = 64;
+        static constexpr size_t NUM_SIZE_CLASSES = 4; // up to 256 bytes, larger blocks use the heap
+        static constexpr size_t BLOCKS_PER_CHUNK = 256;
+
+        struct FreeBlock
+        {
+            FreeBlock* m_Next;
+        };
+
+        struct SizeClass
+        {
+            std::mutex m_Mutex; // held for a pointer swap only
+            FreeBlock* m_FreeList{nullptr};
+            std::vector<std::unique_ptr<std::byte[]>> m_Chunks;
+        };
+
+        static size_t GetSizeClassIndex(size_t size) { return (size - 1) / SIZE_CLASS_GRANULARITY; }
+        void AddChunk(SizeClass& sizeClass, size_t blockSize);
+
+    private:
+        std::array<SizeClass, NUM_SIZE_CLASSES> m_SizeClasses;
+    };
+} // namespace AIAssistant
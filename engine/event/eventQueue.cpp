@@ -19,46 +19,176 @@
    TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
+#include <algorithm>
+#include <bit>
+#include <iterator>
+
 #include "event/eventQueue.h"
 
 namespace AIAssistant
 {
 
-    void EventQueue::Push(EventPtr event)
+    EventQueue::EventQueue(size_t capacity) : m_ConsumerThread{std::this_thread::get_id()}
+    {
+        size_t const cellCount = std::bit_ceil(std::max<size_t>(capacity, 2));
+        m_Cells = std::make_unique<Cell[]>(cellCount);
+        m_Mask = cellCount - 1;
+
+        // cell i is free for the producer that claims position i
+        for (size_t index = 0; index < cellCount; ++index)
+        {
+            m_Cells[index].m_Sequence.store(index, std::memory_order_relaxed);
+        }
+    }
+
+    bool EventQueue::TryPush(EventPtr& event)
     {
-        std::lock_guard<std::mutex> guard(m_QueueAccessMutex);
-        m_Queue.push(std::move(event));
+        size_t position = m_Tail.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            if (m_Closed.load(std::memory_order_relaxed))
+            {
+                return false;
+            }
+
+            Cell& cell = m_Cells[position & m_Mask];
+            size_t const sequence = cell.m_Sequence.load(std::memory_order_acquire);
+            auto const difference = static_cast<std::ptrdiff_t>(sequence - position);
+
+            if (difference == 0)
+            {
+                // free: claim it, on failure position holds the current tail
+                if (m_Tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    cell.m_Event = std::move(event);
+                    cell.m_Sequence.store(position + 1, std::memory_order_release); // publish to the consumer
+                    return true;
+                }
+            }
+            else if (difference < 0)
+            {
+                return false; // the consumer hasn't freed this cell yet: full
+            }
+            else
+            {
+                position = m_Tail.load(std::memory_order_relaxed); // another producer took it
+            }
+        }
+    }
+
+    bool EventQueue::Push(EventPtr event)
+    {
+        // the main thread can't wait for itself to drain the ring; once it has overflowed,
+        // its events stay in the overflow list to keep their order
+        bool const onConsumerThread = (std::this_thread::get_id() == m_ConsumerThread.load(std::memory_order_relaxed));
+        if (onConsumerThread && !m_Overflow.empty())
+        {
+            m_Overflow.push_back(std::move(event));
+            return true;
+        }
+
+        if (TryPush(event))
+        {
+            return true;
+        }
+
+        if (m_Closed.load(std::memory_order_relaxed))
+        {
+            return false;
+        }
+
+        if (onConsumerThread)
+        {
+            m_Overflow.push_back(std::move(event));
+            return true;
+        }
+
+        m_WaitingProducers.fetch_add(1);
+        bool pushed{false};
+        for (;;)
+        {
+            uint32_t const spaceAvailable = m_SpaceAvailable.load();
+            // pairs with the fence in NotifyProducers(): either the consumer sees this producer
+            // waiting, or this producer sees the freed cells
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (TryPush(event))
+            {
+                pushed = true;
+                break;
+            }
+            if (m_Closed.load(std::memory_order_relaxed))
+            {
+                break;
+            }
+            m_SpaceAvailable.wait(spaceAvailable);
+        }
+        m_WaitingProducers.fetch_sub(1);
+        return pushed;
     }
 
-    EventQueue::EventPtr EventQueue::Pop()
+    void EventQueue::PopAll(std::vector<EventPtr>& events)
     {
-        std::lock_guard<std::mutex> guard(m_QueueAccessMutex);
-        if (m_Queue.empty())
+        m_ConsumerThread.store(std::this_thread::get_id(), std::memory_order_relaxed);
+
+        // drain up to the tail seen now, events pushed meanwhile are picked up next frame
+        size_t position = m_Head.load(std::memory_order_relaxed);
+        size_t const tail = m_Tail.load(std::memory_order_acquire);
+        size_t const first = position;
+        events.reserve(events.size() + (tail - position));
+        for (; position != tail; ++position)
         {
-            return nullptr;
+            Cell& cell = m_Cells[position & m_Mask];
+            if (cell.m_Sequence.load(std::memory_order_acquire) != position + 1)
+            {
+                break; // claimed but not yet published, keeps the order
+            }
+            events.push_back(std::move(cell.m_Event));
+            cell.m_Sequence.store(position + m_Mask + 1, std::memory_order_release);
+        }
+
+        if (position != first)
+        {
+            m_Head.store(position, std::memory_order_relaxed);
+            NotifyProducers();
+        }
+
+        // pushed by the main thread while the ring was full, after what was in the ring then
+        if (!m_Overflow.empty())
+        {
+            if (events.empty())
+            {
+                events.swap(m_Overflow);
+            }
+            else
+            {
+                std::move(m_Overflow.begin(), m_Overflow.end(), std::back_inserter(events));
+                m_Overflow.clear();
+            }
         }
-        EventQueue::EventPtr event = std::move(m_Queue.front());
-        m_Queue.pop();
-        return event;
     }
 
-    // Pop all events (main thread should call this periodically)
-    std::vector<EventQueue::EventPtr> EventQueue::PopAll()
+    void EventQueue::NotifyProducers()
     {
-        std::vector<EventQueue::EventPtr> eventVector;
-        std::lock_guard<std::mutex> guard(m_QueueAccessMutex);
-        while (!m_Queue.empty())
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_WaitingProducers.load(std::memory_order_relaxed) > 0)
         {
-            eventVector.push_back(std::move(m_Queue.front()));
-            m_Queue.pop();
+            m_SpaceAvailable.fetch_add(1);
+            m_SpaceAvailable.notify_all();
         }
-        return eventVector;
     }
 
-    size_t EventQueue::Size()
+    size_t EventQueue::Size() const
+    {
+        size_t const head = m_Head.load(std::memory_order_relaxed);
+        size_t const tail = m_Tail.load(std::memory_order_relaxed);
+        return tail > head ? tail - head : 0;
+    }
+
+    void EventQueue::Close()
     {
-        std::lock_guard<std::mutex> guard(m_QueueAccessMutex);
-        return m_Queue.size();
+        m_Closed.store(true);
+        m_SpaceAvailable.fetch_add(1);
+        m_SpaceAvailable.notify_all();
     }
 
 } // namespace AIAssistant
@@ -20,30 +20,77 @@
    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 #pragma once
+#include <atomic>
 #include <memory>
-#include <queue>
+#include <thread>
+#include <vector>
 
 #include "event/event.h"
 
 namespace AIAssistant
 {
 
-    // Thread-safe queue of events for main-thread consumption
+    // Bounded lock-free multi-producer single-consumer queue of events for main-thread consumption.
+    // A ring of cells, each with a sequence number telling whose turn it is (producer or consumer),
+    // as in Dmitry Vyukov's bounded queue. Producers claim a slot with one CAS on the tail,
+    // the main thread drains all ready cells in one batch without any lock.
+    // When the ring is full, Push() blocks until the main thread has made room (back-pressure),
+    // except on the main thread itself, which would wait for itself: its events go to an overflow list.
     class EventQueue
     {
     public:
         using EventPtr = std::shared_ptr<AIAssistant::Event>;
 
-        void Push(EventPtr event);
-        EventPtr Pop();
+    public:
+        // capacity is rounded up to a power of two; the constructing thread is the consumer
+        // until PopAll() is called from another one
+        explicit EventQueue(size_t capacity = DEFAULT_CAPACITY);
+        ~EventQueue() = default;
+
+        EventQueue(EventQueue const&) = delete;
+        EventQueue& operator=(EventQueue const&) = delete;
+
+        // any thread; false if the queue was closed
+        bool Push(EventPtr event);
+        // any thread; false if the queue is full or closed
+        bool TryPush(EventPtr& event);
+
+        // main thread only: appends all pending events to events, which the caller reuses every frame
+        void PopAll(std::vector<EventPtr>& events);
+
+        size_t Size() const; // events in the ring, approximate when producers are active
+        size_t Capacity() const { return m_Mask + 1; }
+
+        // wakes up blocked producers, later pushes are dropped
+        void Close();
 
-        // Pop all events (main thread should call this periodically)
-        std::vector<EventPtr> PopAll();
-        size_t Size();
+    private:
+        void NotifyProducers();
 
     private:
-        std::mutex m_QueueAccessMutex;
-        std::queue<EventPtr> m_Queue;
+        static constexpr size_t DEFAULT_CAPACITY = 64 * 1024;
+        static constexpr size_t CACHE_LINE_SIZE = 64;
+
+        struct Cell
+        {
+            std::atomic<size_t> m_Sequence{0};
+            EventPtr m_Event;
+        };
+
+        std::unique_ptr<Cell[]> m_Cells;
+        size_t m_Mask{0};
+
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_Tail{0}; // next slot for producers
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_Head{0}; // next slot for the consumer, written by it only
+
+        // back-pressure
+        alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> m_SpaceAvailable{0}; // bumped when cells were freed
+        std::atomic<uint32_t> m_WaitingProducers{0};
+        std::atomic<bool> m_Closed{false};
+
+        // consumer side
+        std::atomic<std::thread::id> m_ConsumerThread{};
+        std::vector<EventPtr> m_Overflow; // pushed by the consumer into a full ring
     };
 
 } // namespace AIAssistant
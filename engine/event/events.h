@@ -25,4 +25,5 @@
 #include "event/filesystemEvent.h"
 #include "event/engineEvent.h"
 #include "event/timerEvent.h"
-#include "event/pythonErrorEvent.h"
\ No newline at end of file
+#include "event/pythonErrorEvent.h"
+#include "event/eventPool.h"
\ No newline at end of file
@@ -20,18 +20,30 @@
    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 #pragma once
+#include <string_view>
+
 #include "event/event.h"
+#include "event/pathTable.h"
 
 namespace AIAssistant
 {
     class FileSystemEvent : public AIAssistant::Event
     {
     public:
-        FileSystemEvent(std::string path) : m_Path(std::move(path)) {}
-        const std::string& GetPath() const { return m_Path; }
+        FileSystemEvent(std::string_view path) : m_Path(PathTable::Get().Intern(path)) {}
+        FileSystemEvent(FileSystemEvent const& other) : Event(other), m_Path(other.m_Path)
+        {
+            PathTable::Get().AddReference(m_Path.m_Id);
+        }
+        FileSystemEvent& operator=(FileSystemEvent const&) = delete;
+        ~FileSystemEvent() override { PathTable::Get().Release(m_Path.m_Id); }
+
+        // valid as long as the event
+        const std::string& GetPath() const { return *m_Path.m_Path; }
+        PathTable::PathId GetPathId() const { return m_Path.m_Id; }
 
     protected:
-        std::string m_Path;
+        PathTable::Entry m_Path; // interned, no copy per event; released with the event
     };
 
     class FileAddedEvent : public FileSystemEvent
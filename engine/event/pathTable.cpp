@@ -0,0 +1,93 @@
+/* Copyright (c) 2025 JC Technolabs
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+#include "event/pathTable.h"
+
+namespace AIAssistant
+{
+    PathTable& PathTable::Get()
+    {
+        static PathTable instance;
+        return instance;
+    }
+
+    PathTable::Entry PathTable::Intern(std::string_view path)
+    {
+        std::lock_guard<std::mutex> guard(m_Mutex);
+
+        auto iterator = m_Lookup.find(path);
+        if (iterator != m_Lookup.end())
+        {
+            Slot& slot = m_Slots[iterator->second];
+            ++slot.m_References;
+            return Entry{iterator->second, &slot.m_Path};
+        }
+
+        PathId pathId{0};
+        if (!m_FreeIds.empty())
+        {
+            pathId = m_FreeIds.back();
+            m_FreeIds.pop_back();
+        }
+        else
+        {
+            pathId = static_cast<PathId>(m_Slots.size());
+            m_Slots.emplace_back();
+        }
+        Slot& slot = m_Slots[pathId];
+        slot.m_Path.assign(path);
+        slot.m_References = 1;
+        m_Lookup.emplace(slot.m_Path, pathId);
+        return Entry{pathId, &slot.m_Path};
+    }
+
+    void PathTable::AddReference(PathId pathId)
+    {
+        std::lock_guard<std::mutex> guard(m_Mutex);
+        ++m_Slots[pathId].m_References;
+    }
+
+    void PathTable::Release(PathId pathId)
+    {
+        std::lock_guard<std::mutex> guard(m_Mutex);
+        Slot& slot = m_Slots[pathId];
+        if (--slot.m_References != 0)
+        {
+            return;
+        }
+        m_Lookup.erase(slot.m_Path);
+        slot.m_Path.clear();
+        slot.m_Path.shrink_to_fit();
+        m_FreeIds.push_back(pathId);
+    }
+
+    std::string const& PathTable::GetPath(PathId pathId) const
+    {
+        std::lock_guard<std::mutex> guard(m_Mutex);
+        return m_Slots[pathId].m_Path;
+    }
+
+    size_t PathTable::Size() const
+    {
+        std::lock_guard<std::mutex> guard(m_Mutex);
+        return m_Lookup.size();
+    }
+} // namespace AIAssistant
@@ -0,0 +1,79 @@
+/* Copyright (c) 2025 JC Technolabs
+
+   Permission is hereby granted, free of charge, to any person
+   obtaining a copy of this software and associated documentation files
+   (the "Software"), to deal in the Software without restriction,
+   including without limitation the rights to use, copy, modify, merge,
+   publish, distribute, sublicense, and/or sell copies of the Software,
+   and to permit persons to whom the Software is furnished to do so,
+   subject to the following conditions:
+
+   The above copyright notice and this permission notice shall be
+   included in all copies or substantial portions of the Software.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+   OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+   CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+   TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+   SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
+
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace AIAssistant
+{
+    // Interns file paths: every distinct path is stored once and gets a small id.
+    // File system events carry the id and a pointer to the stored string instead of
+    // their own copy. Entries are reference counted: Intern() and AddReference() take a
+    // reference, Release() drops one, and the last one frees the entry, so transient
+    // paths (timestamped chat files, temporary files) don't accumulate. Its id and slot
+    // are reused later, the strings never move.
+    class PathTable
+    {
+    public:
+        using PathId = uint32_t;
+
+        struct Entry
+        {
+            PathId m_Id;
+            std::string const* m_Path;
+        };
+
+    public:
+        static PathTable& Get();
+
+        Entry Intern(std::string_view path);
+        void AddReference(PathId pathId);
+        void Release(PathId pathId);
+        std::string const& GetPath(PathId pathId) const;
+        size_t Size() const; // paths in use
+
+    private:
+        PathTable() = default;
+        ~PathTable() = default;
+
+        PathTable(PathTable const&) = delete;
+        PathTable& operator=(PathTable const&) = delete;
+
+    private:
+        struct Slot
+        {
+            std::string m_Path;
+            uint32_t m_References{0};
+        };
+
+    private:
+        std::deque<Slot> m_Slots;                              // index: PathId, push_back keeps references valid
+        std::vector<PathId> m_FreeIds;                         // released slots, reused first
+        std::unordered_map<std::string_view, PathId> m_Lookup; // views into m_Slots
+        mutable std::mutex m_Mutex;
+    };
+} // namespace AIAssistant
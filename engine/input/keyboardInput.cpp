@@ -41,7 +41,7 @@ void KeyboardInput::Start()
     }
 
     m_Running = true;
-    m_ListenerTask = Core::g_Core->GetThreadPool().SubmitTask([this]() { Listen(); });
+    m_ListenerTask = Core::g_Core->GetThreadPool().StartService("keyboard input", [this]() { Listen(); });
 }
 
 void KeyboardInput::Stop()
@@ -88,13 +88,13 @@ void KeyboardInput::Listen()
             if (ch == 'q' || ch == 'Q')
             {
                 LOG_CORE_INFO("Keyboard input: Quit requested");
-                auto event = std::make_shared<EngineEvent>(EngineEvent::EngineEventShutdown);
+                auto event = EventPool::Create<EngineEvent>(EngineEvent::EngineEventShutdown);
                 Core::g_Core->PushEvent(event);
                 break;
             }
             else if (ch != '\n' && ch != EOF)
             {
-                auto event = std::make_shared<KeyPressedEvent>(static_cast<char>(ch));
+                auto event = EventPool::Create<KeyPressedEvent>(static_cast<char>(ch));
                 Core::g_Core->PushEvent(event);
             }
         }
@@ -105,13 +105,13 @@ void KeyboardInput::Listen()
             if (ch == 'q' || ch == 'Q')
             {
                 LOG_CORE_INFO("Keyboard: Quit requested");
-                auto event = std::make_shared<EngineEvent>(EngineEvent::EngineEventShutdown);
+                auto event = EventPool::Create<EngineEvent>(EngineEvent::EngineEventShutdown);
                 Core::g_Core->PushEvent(event);
                 break;
             }
             else
             {
-                auto event = std::make_shared<KeyPressedEvent>(static_cast<char>(ch));
+                auto event = EventPool::Create<KeyPressedEvent>(static_cast<char>(ch));
                 Core::g_Core->PushEvent(event);
             }
         }
@@ -96,6 +96,38 @@ namespace AIAssistant
                 engineConfig.m_MaxThreads = 16;
             }
 
+            // python workers out of range: fix it
+            if ((engineConfig.m_PythonWorkers <= 0) || (engineConfig.m_PythonWorkers > 64))
+            {
+                LOG_APP_ERROR("Python workers out of range. Fixing python workers. The config file should have a field "
+                              "similar to '\"python workers\": 4'");
+                engineConfig.m_PythonWorkers = 4;
+            }
+
+            // max concurrent queries out of range: fix it
+            if ((engineConfig.m_MaxConcurrentQueries <= 0) || (engineConfig.m_MaxConcurrentQueries > 1024))
+            {
+                LOG_APP_ERROR("Max concurrent queries out of range. Fixing max concurrent queries. The config file should "
+                              "have a field similar to '\"max concurrent queries\": 64'");
+                engineConfig.m_MaxConcurrentQueries = 64;
+            }
+
+            // reserved interactive queries must leave room for everything else
+            if (engineConfig.m_ReservedInteractiveQueries >= engineConfig.m_MaxConcurrentQueries)
+            {
+                LOG_APP_ERROR("Reserved interactive queries out of range. Fixing reserved interactive queries. It must be "
+                              "less than max concurrent queries, e.g. '\"reserved interactive queries\": 4'");
+                engineConfig.m_ReservedInteractiveQueries = engineConfig.m_MaxConcurrentQueries / 4;
+            }
+
+            // max retries out of range: fix it
+            if (engineConfig.m_MaxRetries > 10)
+            {
+                LOG_APP_ERROR("Max retries out of range. Fixing max retries. The config file should have a field "
+                              "similar to '\"max retries\": 4'");
+                engineConfig.m_MaxRetries = 4;
+            }
+
             // sleep time not set: fix it
             if ((engineConfig.m_SleepDuration <= 0ms) || (engineConfig.m_SleepDuration > 256ms))
             {
@@ -111,6 +143,36 @@ namespace AIAssistant
                               "similar to '\"max file size in kB\": 20'");
                 engineConfig.m_MaxFileSizekB = 20;
             }
+
+            // file watcher debounce out of range: fix it
+            if ((engineConfig.m_FileWatcherDebounce < 0ms) || (engineConfig.m_FileWatcherDebounce > 5000ms))
+            {
+                LOG_APP_ERROR("File watcher debounce out of range. Fixing file watcher debounce. The config file should "
+                              "have a field similar to '\"file watcher debounce in ms\": 100'");
+                engineConfig.m_FileWatcherDebounce = 100ms;
+            }
+
+            // response cache TTL out of range: fix it
+            if (engineConfig.m_ResponseCacheTimeToLive < 0h)
+            {
+                LOG_APP_ERROR("Response cache TTL out of range. Fixing response cache TTL. The config file should have "
+                              "a field similar to '\"response cache TTL in hours\": 168'");
+                engineConfig.m_ResponseCacheTimeToLive = 168h;
+            }
+
+            // negative prices: don't estimate cost
+            for (auto& apiInterface : engineConfig.m_ApiInterfaces)
+            {
+                if ((apiInterface.m_InputPrice < 0.0) || (apiInterface.m_CachedInputPrice < 0.0) ||
+                    (apiInterface.m_OutputPrice < 0.0))
+                {
+                    LOG_APP_ERROR("Negative token price for model '{}'. Cost is not estimated for it.",
+                                  apiInterface.m_Model);
+                    apiInterface.m_InputPrice = 0.0;
+                    apiInterface.m_CachedInputPrice = 0.0;
+                    apiInterface.m_OutputPrice = 0.0;
+                }
+            }
         }
 
         // all checks completed
@@ -104,6 +104,54 @@ namespace AIAssistant
                 engineConfig.m_MaxThreads = static_cast<uint32_t>(maxThreads);
                 ++fieldOccurances[ConfigFields::MaxThreads];
             }
+            else if (jsonObjectKey == "python workers")
+            {
+                CORE_ASSERT((jsonObject.value().type() == ondemand::json_type::number), "type must be number");
+                auto pythonWorkers = static_cast<int64_t>(jsonObject.value().get_int64());
+                LOG_CORE_INFO("python workers: {}", pythonWorkers);
+                engineConfig.m_PythonWorkers = static_cast<uint32_t>(pythonWorkers);
+                ++fieldOccurances[ConfigFields::PythonWorkers];
+            }
+            else if (jsonObjectKey == "max concurrent queries")
+            {
+                CORE_ASSERT((jsonObject.value().type() == ondemand::json_type::number), "type must be number");
+                auto maxConcurrentQueries = static_cast<int64_t>(jsonObject.value().get_int64());
+                LOG_CORE_INFO("max concurrent queries: {}", maxConcurrentQueries);
+                engineConfig.m_MaxConcurrentQueries = static_cast<uint32_t>(maxConcurrentQueries);
+                ++fieldOccurances[ConfigFields::MaxConcurrentQueries];
+            }
+            else if (jsonObjectKey == "reserved interactive queries")
+            {
+                CORE_ASSERT((jsonObject.value().type() == ondemand::json_type::number), "type must be number");
+                auto reservedInteractiveQueries = static_cast<int64_t>(jsonObject.value().get_int64());
+                LOG_CORE_INFO("reserved interactive queries: {}", reservedInteractiveQueries);
+                engineConfig.m_ReservedInteractiveQueries = static_cast<uint32_t>(reservedInteractiveQueries);
+                ++fieldOccurances[ConfigFields::ReservedInteractiveQueries];
+            }
+            else if (jsonObjectKey == "requests per minute")
+            {
+                CORE_ASSERT((jsonObject.value().type() == ondemand::json_type::number), "type must be number");
+                auto requestsPerMinute = static_cast<int64_t>(jsonObject.value().get_int64());
+                LOG_CORE_INFO("requests per minute: {}", requestsPerMinute);
+                engineConfig.m_RequestsPerMinute = static_cast<uint32_t>(requestsPerMinute);
+                ++fieldOccurances[ConfigFields::RequestsPerMinute];
+            }
+            else if (jsonObjectKey == "tokens per minute")
+            {
+                CORE_ASSERT((jsonObject.value().type() == ondemand::json_type::number), "type must be number");
+                auto tokensPerMinute = static_cast<int64_t>(jsonObject.value().get_int64());
+                LOG_CORE_INFO("tokens per minute: {}", tokensPerMinute);
+                engineConfig.m_TokensPerMinute = static_cast<uint32_t>(tokensPerMinute);
+                ++fieldOccurances[ConfigFields::TokensPerMinute];
+            }
+            else if (jsonObjectKey == "max retries")
+            {
+                CORE_ASSERT((jsonObject.value().type() == ondemand::json_type::number), "type must be number");
+                auto maxRetries = static_cast<int64_t>(jsonObject.value().get_int64());
+                LOG_CORE_INFO("max retries: {}", maxRetries);
+                engineConfig.m_MaxRetries = static_cast<uint32_t>(maxRetries);
+                ++fieldOccurances[ConfigFields::MaxRetries];
+            }
             else if (jsonObjectKey == "engine sleep time in run loop in ms")
             {
                 CORE_ASSERT((jsonObject.value().type() == ondemand::json_type::number), "type must be number");
@@ -120,6 +168,85 @@ namespace AIAssistant
                 engineConfig.m_MaxFileSizekB = maxFileSizekB;
                 ++fieldOccurances[ConfigFields::MaxFileSizekB];
             }
+            else if (jsonObjectKey == "write chunk files")
+            {
+                CORE_ASSERT((jsonObject.value().type() == ondemand::json_type::boolean), "type must be boolean");
+                engineConfig.m_WriteChunkFiles = jsonObject.value().get_bool();
+                LOG_CORE_INFO("write chunk files: {}", engineConfig.m_WriteChunkFiles);
+                ++fieldOccurances[ConfigFields::WriteChunkFiles];
+            }
+            else if (jsonObjectKey == "file watcher")
+            {
+                CORE_ASSERT((jsonObject.value().type() == ondemand::json_type::string), "type must be string");
+                std::string_view fileWatcher = jsonObject.value().get_string();
+                LOG_CORE_INFO("file watcher: {}", fileWatcher);
+                if (fileWatcher == "inotify")
+                {
+                    engineConfig.m_FileWatcher = EngineConfig::FileWatcherType::Inotify;
+                }
+                else if (fileWatcher == "polling")
+                {
+                    engineConfig.m_FileWatcher = EngineConfig::FileWatcherType::Polling;
+                }
+                else
+                {
+                    LOG_CORE_WARN("unknown file watcher '{}' in config.json, using polling", fileWatcher);
+                    engineConfig.m_FileWatcher = EngineConfig::FileWatcherType::Polling;
+                }
+                ++fieldOccurances[ConfigFields::FileWatcher];
+            }
+            else if (jsonObjectKey == "file watcher debounce in ms")
+            {
+                CORE_ASSERT((jsonObject.value().type() == ondemand::json_type::number), "type must be number");
+                auto debounce = static_cast<int64_t>(jsonObject.value().get_int64());
+                LOG_CORE_INFO("file watcher debounce in ms: {}", debounce);
+                engineConfig.m_FileWatcherDebounce = std::chrono::milliseconds(debounce);
+                ++fieldOccurances[ConfigFields::FileWatcherDebounce];
+            }
+            else if (jsonObjectKey == "hash algorithm")
+            {
+                CORE_ASSERT((jsonObject.value().type() == ondemand::json_type::string), "type must be string");
+                std::string_view hashAlgorithm = jsonObject.value().get_string();
+                LOG_CORE_INFO("hash algorithm: {}", hashAlgorithm);
+                if (hashAlgorithm == "sha256")
+                {
+                    engineConfig.m_HashAlgorithm = EngineConfig::HashAlgorithm::Sha256;
+                }
+                else if (hashAlgorithm == "xxh64")
+                {
+                    engineConfig.m_HashAlgorithm = EngineConfig::HashAlgorithm::Xxh64;
+                }
+                else
+                {
+                    LOG_CORE_WARN("unknown hash algorithm '{}' in config.json, using sha256", hashAlgorithm);
+                    engineConfig.m_HashAlgorithm = EngineConfig::HashAlgorithm::Sha256;
+                }
+                ++fieldOccurances[ConfigFields::HashAlgorithm];
+            }
+            else if (jsonObjectKey == "response cache size in MB")
+            {
+                CORE_ASSERT((jsonObject.value().type() == ondemand::json_type::number), "type must be number");
+                auto responseCacheSize = static_cast<int64_t>(jsonObject.value().get_int64());
+                LOG_CORE_INFO("response cache size in MB: {}", responseCacheSize);
+                engineConfig.m_ResponseCacheSizeMB = static_cast<size_t>(responseCacheSize);
+                ++fieldOccurances[ConfigFields::ResponseCacheSize];
+            }
+            else if (jsonObjectKey == "response cache TTL in hours")
+            {
+                CORE_ASSERT((jsonObject.value().type() == ondemand::json_type::number), "type must be number");
+                auto responseCacheTimeToLive = static_cast<int64_t>(jsonObject.value().get_int64());
+                LOG_CORE_INFO("response cache TTL in hours: {}", responseCacheTimeToLive);
+                engineConfig.m_ResponseCacheTimeToLive = std::chrono::hours(responseCacheTimeToLive);
+                ++fieldOccurances[ConfigFields::ResponseCacheTimeToLive];
+            }
+            else if (jsonObjectKey == "usage log size in MB")
+            {
+                CORE_ASSERT((jsonObject.value().type() == ondemand::json_type::number), "type must be number");
+                auto usageLogSize = static_cast<int64_t>(jsonObject.value().get_int64());
+                LOG_CORE_INFO("usage log size in MB: {}", usageLogSize);
+                engineConfig.m_UsageLogSizeMB = static_cast<size_t>(usageLogSize);
+                ++fieldOccurances[ConfigFields::UsageLogSize];
+            }
             else if (jsonObjectKey == "verbose")
             {
                 CORE_ASSERT((jsonObject.value().type() == ondemand::json_type::boolean), "type must be boolean");
@@ -127,6 +254,13 @@ namespace AIAssistant
                 LOG_CORE_INFO("verbose: {}", engineConfig.m_Verbose);
                 ++fieldOccurances[ConfigFields::Verbose];
             }
+            else if (jsonObjectKey == "stream responses")
+            {
+                CORE_ASSERT((jsonObject.value().type() == ondemand::json_type::boolean), "type must be boolean");
+                engineConfig.m_StreamResponses = jsonObject.value().get_bool();
+                LOG_CORE_INFO("stream responses: {}", engineConfig.m_StreamResponses);
+                ++fieldOccurances[ConfigFields::StreamResponses];
+            }
             else if (jsonObjectKey == "API interfaces")
             {
                 CORE_ASSERT((jsonObject.value().type() == ondemand::json_type::array), "type must be array");
@@ -249,6 +383,27 @@ namespace AIAssistant
                     }
                     ++fieldOccurances[ConfigFields::InterfaceType];
                 }
+                else if (jsonObjectKey == "input price per 1M tokens")
+                {
+                    CORE_ASSERT((field.value().type() == ondemand::json_type::number), "type must be number");
+                    apiInterface.m_InputPrice = field.value().get_double();
+                    LOG_CORE_INFO("input price per 1M tokens: {}", apiInterface.m_InputPrice);
+                    ++fieldOccurances[ConfigFields::InputPrice];
+                }
+                else if (jsonObjectKey == "cached input price per 1M tokens")
+                {
+                    CORE_ASSERT((field.value().type() == ondemand::json_type::number), "type must be number");
+                    apiInterface.m_CachedInputPrice = field.value().get_double();
+                    LOG_CORE_INFO("cached input price per 1M tokens: {}", apiInterface.m_CachedInputPrice);
+                    ++fieldOccurances[ConfigFields::CachedInputPrice];
+                }
+                else if (jsonObjectKey == "output price per 1M tokens")
+                {
+                    CORE_ASSERT((field.value().type() == ondemand::json_type::number), "type must be number");
+                    apiInterface.m_OutputPrice = field.value().get_double();
+                    LOG_CORE_INFO("output price per 1M tokens: {}", apiInterface.m_OutputPrice);
+                    ++fieldOccurances[ConfigFields::OutputPrice];
+                }
             }
             engineConfig.m_ApiInterfaces.push_back(std::move(apiInterface));
         }
@@ -20,6 +20,7 @@
    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 #pragma once
+#include <chrono>
 #include "simdjson/simdjson.h"
 
 namespace AIAssistant
@@ -51,15 +52,46 @@ namespace AIAssistant
                 std::string m_Url;
                 std::string m_Model;
                 InterfaceType m_InterfaceType{InterfaceType::InvalidAPI};
+
+                // USD per 1M tokens, optional, 0: cost not estimated
+                double m_InputPrice{0.0};
+                double m_CachedInputPrice{0.0};
+                double m_OutputPrice{0.0};
+            };
+
+            enum FileWatcherType
+            {
+                Polling = 0,
+                Inotify
+            };
+
+            enum HashAlgorithm
+            {
+                Sha256 = 0,
+                Xxh64
             };
 
             uint m_MaxThreads{0};
+            uint m_PythonWorkers{4}; // script hooks run in parallel for different documents
+            uint m_MaxConcurrentQueries{64};
+            uint m_ReservedInteractiveQueries{4}; // of m_MaxConcurrentQueries, kept free for chat queries
+            uint m_RequestsPerMinute{0}; // 0: learned from the API's rate limit headers
+            uint m_TokensPerMinute{0};
+            uint m_MaxRetries{4};
             std::chrono::milliseconds m_SleepDuration{0};
             std::string m_QueueFolderFilepath;
             bool m_Verbose{false};
+            bool m_StreamResponses{false};
             size_t m_ApiIndex{0};
             std::vector<ApiInterface> m_ApiInterfaces;
-            size_t m_MaxFileSizekB{20};
+            size_t m_MaxFileSizekB{20}; // larger Markdown documents are split into chunks of this size
+            bool m_WriteChunkFiles{false}; // audit copies of document chunks and their replies
+            FileWatcherType m_FileWatcher{FileWatcherType::Inotify};
+            std::chrono::milliseconds m_FileWatcherDebounce{100};
+            HashAlgorithm m_HashAlgorithm{HashAlgorithm::Sha256};
+            size_t m_ResponseCacheSizeMB{256}; // 0: disabled
+            std::chrono::hours m_ResponseCacheTimeToLive{168};
+            size_t m_UsageLogSizeMB{16}; // 0: disabled
             bool m_ConfigValid{false};
 
             bool IsValid() const { return m_ConfigValid; }
@@ -73,13 +105,30 @@ namespace AIAssistant
             Author,
             QueueFolder,
             MaxThreads,
+            PythonWorkers,
+            MaxConcurrentQueries,
+            ReservedInteractiveQueries,
+            RequestsPerMinute,
+            TokensPerMinute,
+            MaxRetries,
             SleepTime,
             Verbose,
+            StreamResponses,
             Url,
             Model,
             InterfaceType,
             ApiIndex,
             MaxFileSizekB,
+            WriteChunkFiles,
+            FileWatcher,
+            FileWatcherDebounce,
+            HashAlgorithm,
+            ResponseCacheSize,
+            ResponseCacheTimeToLive,
+            UsageLogSize,
+            InputPrice,
+            CachedInputPrice,
+            OutputPrice,
             NumConfigFields
         };
 
@@ -87,18 +136,38 @@ namespace AIAssistant
 
         static constexpr std::array<std::string_view, ConfigFields::NumConfigFields> ConfigFieldNames = //
             {
-                "Format",        //
-                "Description",   //
-                "Author",        //
-                "QueueFolder",   //
-                "MaxThreads",    //
-                "SleepTime",     //
-                "Verbose",       //
-                "Url",           //
-                "Model",         //
-                "InterfaceType", //
-                "IndexAPI"       //
+                "Format",                     //
+                "Description",                //
+                "Author",                     //
+                "QueueFolder",                //
+                "MaxThreads",                 //
+                "PythonWorkers",              //
+                "MaxConcurrentQueries",       //
+                "ReservedInteractiveQueries", //
+                "RequestsPerMinute",          //
+                "TokensPerMinute",            //
+                "MaxRetries",                 //
+                "SleepTime",                  //
+                "Verbose",                    //
+                "StreamResponses",            //
+                "Url",                        //
+                "Model",                      //
+                "InterfaceType",              //
+                "IndexAPI",                   //
+                "MaxFileSizekB",              //
+                "WriteChunkFiles",            //
+                "FileWatcher",                //
+                "FileWatcherDebounce",        //
+                "HashAlgorithm",              //
+                "ResponseCacheSize",          //
+                "ResponseCacheTimeToLive",    //
+                "UsageLogSize",               //
+                "InputPrice",                 //
+                "CachedInputPrice",           //
+                "OutputPrice"                 //
         };
+        // a missing name leaves the last entry empty and shifts every later name
+        static_assert(!ConfigFieldNames[ConfigFields::NumConfigFields - 1].empty(), "ConfigFieldNames is missing an entry");
 
     public:
         ConfigParser(std::string const&);
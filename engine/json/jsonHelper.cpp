@@ -19,23 +19,245 @@
    TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define JSON_HELPER_X86_64
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
 #include "json/jsonHelper.h"
 
 namespace AIAssistant
 {
+    namespace
+    {
+        // a byte that cannot be copied as is: control characters, '"' and '\\' need escaping,
+        // non-ASCII bytes start a UTF-8 sequence that has to be validated
+        inline bool IsSpecial(unsigned char c) { return (c < 0x20) || (c == '"') || (c == '\\') || (c >= 0x80); }
+
+        size_t FindSpecialScalar(char const* data, size_t size, size_t position)
+        {
+            // eight bytes at a time, a flagged word is resolved byte by byte
+            constexpr uint64_t ones = 0x0101010101010101ULL;
+            constexpr uint64_t highBits = 0x8080808080808080ULL;
+            auto hasZeroByte = [](uint64_t word) { return (word - ones) & ~word & highBits; };
+
+            while (position + sizeof(uint64_t) <= size)
+            {
+                uint64_t word;
+                std::memcpy(&word, data + position, sizeof(word));
+                uint64_t flags = (word - ones * 0x20) |               // byte < 0x20 (or >= 0x80)
+                                 hasZeroByte(word ^ (ones * '"')) |   // byte == '"'
+                                 hasZeroByte(word ^ (ones * '\\')) |  // byte == '\\'
+                                 word;                                // byte >= 0x80
+                if (flags & highBits)
+                {
+                    break;
+                }
+                position += sizeof(uint64_t);
+            }
+
+            while ((position < size) && !IsSpecial(static_cast<unsigned char>(data[position])))
+            {
+                ++position;
+            }
+            return position;
+        }
+
+#ifdef JSON_HELPER_X86_64
+        inline int CountTrailingZeros(uint32_t mask)
+        {
+#ifdef _MSC_VER
+            unsigned long index;
+            _BitScanForward(&index, mask);
+            return static_cast<int>(index);
+#else
+            return __builtin_ctz(mask);
+#endif
+        }
+
+        // SSE2 is part of x86-64, no runtime check needed
+        size_t FindSpecialSse2(char const* data, size_t size, size_t position)
+        {
+            __m128i const quote = _mm_set1_epi8('"');
+            __m128i const backslash = _mm_set1_epi8('\\');
+            __m128i const lastControl = _mm_set1_epi8(0x1F);
+
+            while (position + 16 <= size)
+            {
+                __m128i chunk = _mm_loadu_si128(reinterpret_cast<__m128i const*>(data + position));
+                __m128i control = _mm_cmpeq_epi8(_mm_min_epu8(chunk, lastControl), chunk); // unsigned <= 0x1F
+                __m128i escape = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)),
+                                              control);
+                // movemask of the chunk itself flags the non-ASCII bytes
+                uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(escape) | _mm_movemask_epi8(chunk));
+                if (mask)
+                {
+                    return position + CountTrailingZeros(mask);
+                }
+                position += 16;
+            }
+            return FindSpecialScalar(data, size, position);
+        }
+
+#ifdef _MSC_VER
+        size_t FindSpecialAvx2(char const* data, size_t size, size_t position)
+#else
+        __attribute__((target("avx2"))) size_t FindSpecialAvx2(char const* data, size_t size, size_t position)
+#endif
+        {
+            __m256i const quote = _mm256_set1_epi8('"');
+            __m256i const backslash = _mm256_set1_epi8('\\');
+            __m256i const lastControl = _mm256_set1_epi8(0x1F);
+
+            while (position + 32 <= size)
+            {
+                __m256i chunk = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(data + position));
+                __m256i control = _mm256_cmpeq_epi8(_mm256_min_epu8(chunk, lastControl), chunk);
+                __m256i escape = _mm256_or_si256(
+                    _mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote), _mm256_cmpeq_epi8(chunk, backslash)), control);
+                uint32_t mask =
+                    static_cast<uint32_t>(_mm256_movemask_epi8(escape)) | static_cast<uint32_t>(_mm256_movemask_epi8(chunk));
+                if (mask)
+                {
+                    return position + CountTrailingZeros(mask);
+                }
+                position += 32;
+            }
+            return FindSpecialSse2(data, size, position);
+        }
+
+        bool CpuSupportsAvx2()
+        {
+#ifdef _MSC_VER
+            int info[4];
+            __cpuid(info, 0);
+            if (info[0] < 7)
+            {
+                return false;
+            }
+            __cpuid(info, 1);
+            bool osSavesYmm = (info[2] & (1 << 27)) && ((_xgetbv(0) & 0x6) == 0x6);
+            __cpuidex(info, 7, 0);
+            return osSavesYmm && (info[1] & (1 << 5));
+#else
+            return __builtin_cpu_supports("avx2");
+#endif
+        }
+#endif
+
+        using FindSpecialFunction = size_t (*)(char const*, size_t, size_t);
+
+        FindSpecialFunction SelectFindSpecial()
+        {
+#ifdef JSON_HELPER_X86_64
+            if (CpuSupportsAvx2())
+            {
+                LOG_CORE_INFO("JSON escaping: AVX2");
+                return FindSpecialAvx2;
+            }
+            LOG_CORE_INFO("JSON escaping: SSE2");
+            return FindSpecialSse2;
+#else
+            LOG_CORE_INFO("JSON escaping: scalar");
+            return FindSpecialScalar;
+#endif
+        }
+
+        // length of the well-formed UTF-8 sequence at data[0], 0 if it is malformed
+        // (stray continuation byte, overlong encoding, surrogate, above U+10FFFF, truncated)
+        size_t ValidUtf8Length(unsigned char const* data, size_t available)
+        {
+            unsigned char lead = data[0];
+            size_t length{0};
+            unsigned char secondMin{0x80};
+            unsigned char secondMax{0xBF};
+
+            if ((lead >= 0xC2) && (lead <= 0xDF))
+            {
+                length = 2;
+            }
+            else if ((lead >= 0xE0) && (lead <= 0xEF))
+            {
+                length = 3;
+                secondMin = (lead == 0xE0) ? 0xA0 : 0x80; // overlong
+                secondMax = (lead == 0xED) ? 0x9F : 0xBF; // surrogates
+            }
+            else if ((lead >= 0xF0) && (lead <= 0xF4))
+            {
+                length = 4;
+                secondMin = (lead == 0xF0) ? 0x90 : 0x80; // overlong
+                secondMax = (lead == 0xF4) ? 0x8F : 0xBF; // above U+10FFFF
+            }
+            else
+            {
+                return 0;
+            }
+
+            if ((available < length) || (data[1] < secondMin) || (data[1] > secondMax))
+            {
+                return 0;
+            }
+            for (size_t index = 2; index < length; ++index)
+            {
+                if ((data[index] & 0xC0) != 0x80)
+                {
+                    return 0;
+                }
+            }
+            return length;
+        }
+    } // namespace
+
     std::string JsonHelper::SanitizeForJson(std::string const& input)
     {
         std::string output;
-        output.reserve(input.size());
+        AppendSanitizedForJson(output, input);
+        return output;
+    }
 
-        for (char c : input)
+    void JsonHelper::AppendSanitizedForJson(std::string& output, std::string_view input)
+    {
+        output.reserve(output.size() + input.size() + input.size() / 16);
+
+        size_t position{0};
+        while (position < input.size())
         {
-            switch (c)
+            // copy the run of plain bytes in one go
+            size_t next = FindNextEscape(input, position);
+            output.append(input.data() + position, next - position);
+            if (next == input.size())
             {
-                case '':
+                break;
+            }
+            position = next;
+
+            unsigned char c = static_cast<unsigned char>(input[position]);
+            if (c >= 0x80)
+            {
+                auto const* bytes = reinterpret_cast<unsigned char const*>(input.data()) + position;
+                size_t length = ValidUtf8Length(bytes, input.size() - position);
+                if (length == 0)
                 {
-                    break;
+                    // the API rejects the whole request for one bad byte
+                    output += "\xEF\xBF\xBD"; // U+FFFD replacement character
+                    ++position;
                 }
+                else
+                {
+                    output.append(input.data() + position, length);
+                    position += length;
+                }
+                continue;
+            }
+
+            switch (c)
+            {
                 case '\"':
                 {
                     output += "\\\"";
@@ -46,6 +268,16 @@ namespace AIAssistant
                     output += "\\\\";
                     break;
                 }
+                case '\b':
+                {
+                    output += "\\b";
+                    break;
+                }
+                case '\f':
+                {
+                    output += "\\f";
+                    break;
+                }
                 case '\n':
                 {
                     output += "\\n";
@@ -63,12 +295,136 @@ namespace AIAssistant
                 }
                 default:
                 {
-                    output += c;
+                    // remaining control characters U+0000 to U+001F
+                    constexpr char hexDigits[] = "0123456789abcdef";
+                    char escaped[] = {'\\', 'u', '0', '0', hexDigits[c >> 4], hexDigits[c & 0xF]};
+                    output.append(escaped, sizeof(escaped));
                     break;
                 }
             }
+            ++position;
         }
+    }
 
-        return output;
+    std::string_view JsonHelper::UnescapeInPlace(char* string)
+    {
+        auto parseHex4 = [](char const* digits) -> int32_t
+        {
+            int32_t value{0};
+            for (int index = 0; index < 4; ++index)
+            {
+                char c = digits[index];
+                int32_t digit = ((c >= '0') && (c <= '9'))   ? (c - '0')
+                                : ((c >= 'a') && (c <= 'f')) ? (c - 'a' + 10)
+                                : ((c >= 'A') && (c <= 'F')) ? (c - 'A' + 10)
+                                                             : -1;
+                if (digit < 0)
+                {
+                    return -1;
+                }
+                value = (value << 4) | digit;
+            }
+            return value;
+        };
+
+        char const* read = string;
+        // nothing to decode: no byte is written
+        while ((*read != '"') && (*read != '\\'))
+        {
+            ++read;
+        }
+        char* write = string + (read - string);
+
+        while (*read != '"')
+        {
+            if (*read != '\\')
+            {
+                *write++ = *read++;
+                continue;
+            }
+
+            char escaped = read[1];
+            read += 2;
+            switch (escaped)
+            {
+                case 'b':
+                    *write++ = '\b';
+                    break;
+                case 'f':
+                    *write++ = '\f';
+                    break;
+                case 'n':
+                    *write++ = '\n';
+                    break;
+                case 'r':
+                    *write++ = '\r';
+                    break;
+                case 't':
+                    *write++ = '\t';
+                    break;
+                case 'u':
+                {
+                    // a \u escape never reads past the closing quote: parseHex4 stops at the first non-hex digit
+                    int32_t codePoint = parseHex4(read);
+                    if (codePoint < 0)
+                    {
+                        // malformed escape, copied through: writing more than was read would overrun
+                        // the closing quote after a few of them
+                        *write++ = '\\';
+                        *write++ = 'u';
+                        break;
+                    }
+                    read += 4;
+                    if ((codePoint >= 0xD800) && (codePoint <= 0xDBFF) && (read[0] == '\\') && (read[1] == 'u'))
+                    {
+                        int32_t low = parseHex4(read + 2);
+                        if ((low >= 0xDC00) && (low <= 0xDFFF))
+                        {
+                            codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                            read += 6;
+                        }
+                    }
+                    if ((codePoint >= 0xD800) && (codePoint <= 0xDFFF))
+                    {
+                        codePoint = 0xFFFD; // lone surrogate, 3 bytes for the 6 of its escape
+                    }
+
+                    if (codePoint < 0x80)
+                    {
+                        *write++ = static_cast<char>(codePoint);
+                    }
+                    else if (codePoint < 0x800)
+                    {
+                        *write++ = static_cast<char>(0xC0 | (codePoint >> 6));
+                        *write++ = static_cast<char>(0x80 | (codePoint & 0x3F));
+                    }
+                    else if (codePoint < 0x10000)
+                    {
+                        *write++ = static_cast<char>(0xE0 | (codePoint >> 12));
+                        *write++ = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+                        *write++ = static_cast<char>(0x80 | (codePoint & 0x3F));
+                    }
+                    else
+                    {
+                        *write++ = static_cast<char>(0xF0 | (codePoint >> 18));
+                        *write++ = static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+                        *write++ = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+                        *write++ = static_cast<char>(0x80 | (codePoint & 0x3F));
+                    }
+                    break;
+                }
+                default: // '"', '\\' and '/' stand for themselves
+                    *write++ = escaped;
+                    break;
+            }
+        }
+        return std::string_view(string, static_cast<size_t>(write - string));
+    }
+
+    size_t JsonHelper::FindNextEscape(std::string_view input, size_t position)
+    {
+        // AVX2 if the CPU has it, decided on first use
+        static FindSpecialFunction const findSpecial = SelectFindSpecial();
+        return findSpecial(input.data(), input.size(), position);
     }
 } // namespace AIAssistant
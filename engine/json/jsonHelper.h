@@ -20,6 +20,9 @@
    SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.*/
 
 #pragma once
+#include <string>
+#include <string_view>
+
 #include "engine.h"
 
 namespace AIAssistant
@@ -31,5 +34,18 @@ namespace AIAssistant
         ~JsonHelper() = default;
 
         std::string SanitizeForJson(std::string const& input);
+        // escapes input for a JSON string literal and appends it to output,
+        // malformed UTF-8 is replaced by U+FFFD
+        void AppendSanitizedForJson(std::string& output, std::string_view input);
+
+        // decodes the JSON string starting right after its opening quote in place and returns it;
+        // the decoded text is never longer than the escaped text, the bytes behind it up to the
+        // closing quote are left as they were
+        std::string_view UnescapeInPlace(char* string);
+
+    private:
+        // position of the first byte at or after position that needs escaping or UTF-8 validation,
+        // input.size() if none
+        static size_t FindNextEscape(std::string_view input, size_t position);
     };
 } // namespace AIAssistant
@@ -217,4 +217,63 @@ project "jarvisAgent"
 	include "vendor/openssl/ssl.lua"
 	include "vendor/pdcursesmod/pdcursesmod.lua"
 
+-- ================================================================
+-- Micro-benchmarks (not part of the agent)
+-- Usage:
+--   make config=release jsonSanitizeBench
+--   bin/Release/jsonSanitizeBench
+-- ================================================================
+project "jsonSanitizeBench"
+    kind "ConsoleApp"
+    language "C++"
+    cppdialect "C++20"
+    staticruntime "on"
+
+    targetdir "bin/%{cfg.buildcfg}"
+    objdir ("bin-int/%{cfg.buildcfg}")
+
+    -- logging compiled out, so the escaping code links without the engine core
+    defines
+    {
+        "DISTRIBUTION_BUILD"
+    }
+
+    files
+    {
+        "bench/jsonSanitizeBench.cpp",
+        "engine/json/jsonHelper.h",
+        "engine/json/jsonHelper.cpp"
+    }
 
+    includedirs
+    {
+        "engine/",
+        "application/",
+        "vendor/",
+        "vendor/spdlog/include",
+        "vendor/curl/include",
+        "vendor/thread-pool/include",
+        "vendor/tracy/include",
+        "vendor/openssl/include",
+        "vendor/crow/include/crow",
+        "vendor/asio/asio/include",
+        "vendor/pdcursesmod"
+    }
+
+    filter "system:linux"
+        defines { "LINUX" }
+
+    filter "system:windows"
+        systemversion "latest"
+
+    filter "configurations:Debug"
+        defines { "DEBUG" }
+        runtime "Debug"
+        symbols "on"
+
+    filter "configurations:Release"
+        defines { "NDEBUG" }
+        runtime "Release"
+        optimize "on"
+
+    filter {}
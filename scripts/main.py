@@ -7,16 +7,15 @@ JarvisAgent Python Scripting Layer
 
 Supports:
 - Document conversion using MarkItDown CLI (PDF/DOCX/XLSX/PPTX/etc.)
-- Markdown chunking
-- Chunk-output combining
 - Future STNG/CNTX/TASK preprocessing
 
+Large Markdown files (converted documents included) are split into chunks,
+queried and joined again by the C++ engine (MarkdownChunker, SessionManager).
+
 Copyright (c) 2025 JC Technolabs
 License: GPL-3.0
 """
 
-from pathlib import Path
-import re
 import sys
 import ctypes
 import traceback
@@ -29,8 +28,6 @@ from helpers.fileutils import (
     is_pptx,
 )
 from helpers.markitdown_tools import convert_with_markitdown
-from helpers.md_chunker import chunk_markdown_if_needed
-from helpers.chunk_combiner import handle_chunk_output_added
 
 
 # --------------------------------------------------------------------
@@ -115,27 +112,6 @@ def _global_exception_hook(exc_type, exc, tb):
 sys.excepthook = _global_exception_hook
 
 
-# --------------------------------------------------------------------
-# Regex for chunk output files
-# --------------------------------------------------------------------
-CHUNK_OUTPUT_REGEX = re.compile(r"^chunk_(\d+)\.output\.md$")
-
-
-def is_md_up_to_date(markdown_path: Path) -> bool:
-    """Return True if foo.output.md exists and is newer."""
-    if not markdown_path.name.endswith(".md"):
-        return False
-
-    out_path = markdown_path.with_suffix(".output.md")
-    if not out_path.exists():
-        return False
-
-    try:
-        return out_path.stat().st_mtime >= markdown_path.stat().st_mtime
-    except OSError:
-        return False
-
-
 # --------------------------------------------------------------------
 # Hook implementations
 # --------------------------------------------------------------------
@@ -152,7 +128,6 @@ def OnEvent(event):
 
     event_type = event.get("type")
     file_path = event.get("path", "")
-    file_name = Path(file_path).name
 
     # ------------------------------------------------------------
     # DOCUMENT CONVERSION (PDF, DOCX, XLSX, PPTX)
@@ -171,43 +146,6 @@ def OnEvent(event):
             notify_python_error(f"Conversion failed for {file_path}: {exception}")
         return
 
-    # ------------------------------------------------------------
-    # COMBINE CHUNK OUTPUT FILES
-    # ------------------------------------------------------------
-    if event_type == "FileAdded" and CHUNK_OUTPUT_REGEX.match(file_name):
-        try:
-            handle_chunk_output_added(file_path)
-        except Exception as exception:
-            notify_python_error(f"Chunk combining failed for {file_path}: {exception}")
-        return
-
-    # ------------------------------------------------------------
-    # CHUNK LARGE MARKDOWN FILES
-    # ------------------------------------------------------------
-    if event_type == "FileAdded" and file_path.endswith(".md"):
-
-        # skip combined results
-        if file_name.endswith(".output.md"):
-            return
-
-        # skip chunk outputs
-        if CHUNK_OUTPUT_REGEX.match(file_name):
-            return
-
-        md_path = Path(file_path)
-
-        # skip if already processed
-        if is_md_up_to_date(md_path):
-            log_info(f"Markdown already processed — skipping: {file_path}")
-            return
-
-        log_info(f"Markdown file detected for chunking: {file_path}")
-        try:
-            chunk_markdown_if_needed(file_path)
-        except Exception as exception:
-            notify_python_error(f"Markdown chunking failed for {file_path}: {exception}")
-        return
-
 
 def OnShutdown():
     log_info("Python OnShutdown() called.")